@@ -0,0 +1,231 @@
+// microbench: per-operation cost of the simulation plumbing.
+//
+// Usage: microbench [filter]
+//
+// Times the primitives that every simulated cycle goes through (queue, hive, Channel,
+// ReadPort, WritePort, Clock, IssueBuffer) in isolation and reports nanoseconds per operation.
+// Only benchmarks whose name contains the optional filter string are run.
+
+#include "backend/cdb.hpp"
+#include "backend/issue_buffer.hpp"
+#include "instruction.hpp"
+#include "middlend/rob.hpp"
+#include "utils/bus.hpp"
+#include "utils/clock.hpp"
+#include "utils/hive.hpp"
+#include "utils/port.hpp"
+#include "utils/queue.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Keeps the compiler from discarding a value or the memory behind it.
+template <typename T>
+inline void do_not_optimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+const char* filter = nullptr;
+
+/**
+ * @brief Runs body(batch) until at least min_seconds have elapsed and prints ns per operation.
+ * @param ops_per_call How many logical operations one call of body(1) performs.
+ */
+template <typename Body>
+void bench(const std::string& name, double ops_per_call, Body&& body, double min_seconds = 0.2) {
+    if (filter && name.find(filter) == std::string::npos) {
+        return;
+    }
+    using SteadyClock = std::chrono::steady_clock;
+    body(1000); // warm up
+    size_t batch = 1000;
+    double elapsed = 0;
+    size_t calls = 0;
+    while (elapsed < min_seconds) {
+        auto t0 = SteadyClock::now();
+        body(batch);
+        elapsed += std::chrono::duration<double>(SteadyClock::now() - t0).count();
+        calls += batch;
+        batch *= 2;
+    }
+    std::printf("%-48s %8.2f ns/op\n", name.c_str(), elapsed * 1e9 / (static_cast<double>(calls) * ops_per_call));
+}
+
+FilledInstruction sample_instruction(RobIDType id) {
+    FilledInstruction fi;
+    fi.id = id;
+    fi.ins.op = OpType::ADD;
+    fi.ins.pc = id * 4;
+    fi.q_rs1 = id % 3;
+    fi.q_rs2 = id % 5;
+    return fi;
+}
+
+void bench_queue() {
+    queue<ROBEntry, ROB_SIZE> q;
+    ROBEntry entry{};
+    bench("queue<ROBEntry>::push_back+pop_front", 2, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            entry.id = static_cast<RobIDType>(i);
+            q.push_back(entry);
+            do_not_optimize(q.front());
+            q.pop_front();
+        }
+    });
+
+    for (size_t i = 0; i < ROB_SIZE; ++i) {
+        entry.id = static_cast<RobIDType>(i);
+        q.push_back(entry);
+    }
+    bench("queue<ROBEntry>::operator[] (full scan)", ROB_SIZE, [&](size_t n) {
+        for (size_t k = 0; k < n; ++k) {
+            RobIDType sum = 0;
+            for (size_t i = 0; i < q.size(); ++i) {
+                sum += q[i].id;
+            }
+            do_not_optimize(sum);
+        }
+    });
+}
+
+void bench_hive() {
+    hive<FilledInstruction, RS_ALU_SIZE> h;
+    const FilledInstruction fi = sample_instruction(1);
+    bench("hive<FilledInstruction>::insert+erase", 2, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            auto it = h.insert(fi);
+            h.erase(*it);
+        }
+    });
+
+    // Half-occupied hive with holes, the common shape of a reservation station.
+    for (size_t i = 0; i < RS_ALU_SIZE; ++i) {
+        h.insert(sample_instruction(static_cast<RobIDType>(i + 1)));
+    }
+    for (auto it = h.begin(); it != h.end();) {
+        it = h.erase(it);
+        if (it != h.end()) ++it;
+    }
+    bench("hive<FilledInstruction>::iterate (half full)", RS_ALU_SIZE / 2, [&](size_t n) {
+        for (size_t k = 0; k < n; ++k) {
+            RobIDType sum = 0;
+            for (auto& e : h) {
+                sum += e.q_rs1;
+            }
+            do_not_optimize(sum);
+        }
+    });
+}
+
+void bench_wakeup() {
+    // A full 128-entry station where every entry waits on rs1 for its own producer. Each
+    // broadcast wakes the oldest waiter, which issues, and a new waiter takes its slot.
+    constexpr size_t SIZE = 128;
+    constexpr RobIDType TAGS = 1024; // more than SIZE, so no two waiters share a tag
+    IssueBuffer<SIZE> buffer("microbench");
+    auto waiter = [](RobIDType tag) {
+        FilledInstruction fi = sample_instruction(tag);
+        fi.q_rs1 = tag;
+        fi.q_rs2 = 0;
+        return fi;
+    };
+    size_t produced = 0;
+    size_t consumed = 0;
+    auto tag_of = [](size_t n) { return static_cast<RobIDType>(n % TAGS + 1); };
+    for (; produced < SIZE; ++produced) {
+        buffer.insert(waiter(tag_of(produced)));
+    }
+    bench("IssueBuffer<128> wakeup+select+reinsert", 1, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            buffer.wakeup(CDBResult{tag_of(consumed++), static_cast<RegDataType>(i)});
+            if (auto slot = buffer.select()) {
+                do_not_optimize(buffer[*slot]);
+                buffer.erase(*slot);
+            }
+            buffer.insert(waiter(tag_of(produced++)));
+        }
+    });
+}
+
+void bench_channel() {
+    Clock::getInstance().reset();
+    Channel<FilledInstruction> c;
+    const FilledInstruction fi = sample_instruction(7);
+    bench("Channel<FilledInstruction> send+tick+receive", 1, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            c.send(fi);
+            c.tick();
+            const FilledInstruction* r = c.receive();
+            do_not_optimize(*r);
+            c.tick();
+        }
+    });
+}
+
+struct CounterHolder {
+    uint32_t base = 1;
+    uint32_t read(uint32_t x) { return x + base; }
+};
+
+void bench_ports() {
+    // Nothing subscribes to the clock, so this is one read plus an empty tick.
+    Clock& clock = Clock::getInstance();
+    clock.reset();
+    CounterHolder holder;
+    ReadPort<&CounterHolder::read> read_port(holder);
+    bench("ReadPort::read + Clock::tick", 1, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            auto r = read_port.read(static_cast<uint32_t>(i));
+            do_not_optimize(r);
+            clock.tick();
+        }
+    });
+    clock.reset();
+
+    WritePort<CDBResult> write_port;
+    bench("WritePort::push+consume", 1, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            write_port.push(CDBResult{static_cast<RobIDType>(i), static_cast<RegDataType>(i)});
+            auto r = write_port.consume();
+            do_not_optimize(r);
+        }
+    });
+}
+
+void bench_clock() {
+    Clock& clock = Clock::getInstance();
+    for (size_t subscribers : {1, 16, 64, 256}) {
+        clock.reset();
+        std::vector<uint64_t> counters(subscribers);
+        for (size_t i = 0; i < subscribers; ++i) {
+            clock.subscribe([&counters, i] { ++counters[i]; }, i % 2 ? FALLING : RISING);
+        }
+        bench("Clock::tick, " + std::to_string(subscribers) + " subscribers", 1, [&](size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                clock.tick();
+            }
+        });
+        do_not_optimize(counters.data());
+    }
+    clock.reset();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        filter = argv[1];
+    }
+    bench_queue();
+    bench_hive();
+    bench_wakeup();
+    bench_channel();
+    bench_ports();
+    bench_clock();
+    return 0;
+}
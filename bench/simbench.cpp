@@ -0,0 +1,220 @@
+// simbench: host-side throughput benchmark for the simulator.
+//
+// Usage: simbench [--out results.json] [--baseline baseline.json] [--tolerance percent]
+//                 [--repeat n]
+//
+// Runs the fixed workload set through CPU and reports simulated kilo-cycles per second,
+// committed instructions per second and CPU construction (start-up) time per workload,
+// and the peak RSS of the whole run.
+// Each result is checked against the functional model. With --baseline, throughput is
+// compared against a stored run and the exit status is 1 if any workload got slower
+// than the tolerance allows, or if its cycle count no longer matches the baseline:
+// throughput depends on the mix of cycles simulated, so a change to the modelled
+// pipeline must re-record the baseline.
+
+#include "cpu.hpp"
+#include "cosim/iss.hpp"
+#include "utils/clock.hpp"
+#include "utils/stats.hpp"
+#include "workloads.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+struct Result {
+    std::string name;
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    double seconds = 0;
+    double startup_ms = 0;
+
+    double kcycles_per_sec() const { return cycles / seconds / 1e3; }
+    double instructions_per_sec() const { return instructions / seconds; }
+};
+
+// Process-wide and never decreasing, so it is only meaningful for the run as a whole.
+long peak_rss_kb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+RegDataType reference_a0(const std::vector<std::byte>& image) {
+    FunctionalModel model(image);
+    while (model.fetch(model.get_pc()) != rv32i::HALT_WORD) {
+        model.step();
+    }
+    return model.get_regs()[10];
+}
+
+Result run_workload(const workloads::Workload& w) {
+    const auto image = rv32i::to_image(w.program);
+    const RegDataType expected = reference_a0(image);
+
+    Result r;
+    r.name = w.name;
+
+    auto t0 = SteadyClock::now();
+    Clock::getInstance().reset();
+    Stats::getInstance().reset();
+    auto cpu = std::make_unique<CPU>(image);
+    auto t1 = SteadyClock::now();
+    RegDataType a0 = cpu->run();
+    auto t2 = SteadyClock::now();
+
+    r.cycles = Clock::getInstance().getTime();
+    r.instructions = cpu->committed_count();
+    r.startup_ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    r.seconds = std::chrono::duration<double>(t2 - t1).count();
+
+    if (a0 != expected) {
+        std::ostringstream oss;
+        oss << w.name << ": a0 = " << a0 << ", functional model says " << expected;
+        throw std::runtime_error(oss.str());
+    }
+    return r;
+}
+
+std::string to_json(const std::vector<Result>& results, long rss_kb) {
+    std::ostringstream os;
+    os << "{\n  \"peak_rss_kb\": " << rss_kb << ",\n  \"workloads\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        os << "    {\"name\": \"" << r.name << "\""
+           << ", \"cycles\": " << r.cycles
+           << ", \"instructions\": " << r.instructions
+           << ", \"seconds\": " << r.seconds
+           << ", \"kcycles_per_sec\": " << r.kcycles_per_sec()
+           << ", \"instructions_per_sec\": " << r.instructions_per_sec()
+           << ", \"startup_ms\": " << r.startup_ms << "}"
+           << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+    return os.str();
+}
+
+// Reads a numeric field of the named workload from a file written by to_json().
+bool baseline_value(const std::string& json, const std::string& workload, const std::string& field,
+                    double& value) {
+    size_t obj = json.find("\"name\": \"" + workload + "\"");
+    if (obj == std::string::npos) {
+        return false;
+    }
+    size_t end = json.find('}', obj);
+    size_t key = json.find("\"" + field + "\":", obj);
+    if (key == std::string::npos || key > end) {
+        return false;
+    }
+    value = std::strtod(json.c_str() + key + field.size() + 3, nullptr);
+    return true;
+}
+
+bool compare_with_baseline(const std::vector<Result>& results, const std::string& path, double tolerance) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "simbench: cannot read baseline " << path << "\n";
+        return false;
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+    const std::string json = ss.str();
+
+    bool ok = true;
+    std::printf("\n%-12s %16s %16s %9s\n", "workload", "baseline kc/s", "current kc/s", "change");
+    for (const Result& r : results) {
+        double base;
+        if (!baseline_value(json, r.name, "kcycles_per_sec", base) || base <= 0) {
+            std::printf("%-12s %16s %16.1f %9s\n", r.name.c_str(), "-", r.kcycles_per_sec(), "new");
+            continue;
+        }
+        double base_cycles;
+        const bool stale = baseline_value(json, r.name, "cycles", base_cycles) &&
+                           static_cast<uint64_t>(base_cycles) != r.cycles;
+        double change = (r.kcycles_per_sec() - base) / base * 100.0;
+        bool regressed = change < -tolerance;
+        ok = ok && !regressed && !stale;
+        std::printf("%-12s %16.1f %16.1f %+8.1f%%%s\n", r.name.c_str(), base, r.kcycles_per_sec(), change,
+                    regressed ? "  REGRESSION" : "");
+        if (stale) {
+            std::printf("%-12s baseline has %.0f cycles, now %llu: re-record the baseline\n", "",
+                        base_cycles, static_cast<unsigned long long>(r.cycles));
+        }
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string out_path;
+    std::string baseline_path;
+    double tolerance = 10.0;
+    int repeat = 1;
+    for (int i = 1; i < argc; ++i) {
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "simbench: missing value for " << argv[i] << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (std::strcmp(argv[i], "--out") == 0) out_path = next();
+        else if (std::strcmp(argv[i], "--baseline") == 0) baseline_path = next();
+        else if (std::strcmp(argv[i], "--tolerance") == 0) tolerance = std::atof(next());
+        else if (std::strcmp(argv[i], "--repeat") == 0) repeat = std::max(1, std::atoi(next()));
+        else {
+            std::cerr << "usage: " << argv[0]
+                      << " [--out file] [--baseline file] [--tolerance percent] [--repeat n]\n";
+            return 2;
+        }
+    }
+
+    std::vector<Result> results;
+    try {
+        std::printf("%-12s %10s %10s %12s %14s %11s\n", "workload", "cycles", "insts", "kcycles/s",
+                    "insts/s", "startup ms");
+        for (const auto& w : workloads::standard_set()) {
+            // Keep the fastest of the repeated runs to reduce host noise.
+            Result best = run_workload(w);
+            for (int k = 1; k < repeat; ++k) {
+                Result r = run_workload(w);
+                if (r.seconds < best.seconds) {
+                    best = r;
+                }
+            }
+            std::printf("%-12s %10llu %10llu %12.1f %14.0f %11.3f\n", best.name.c_str(),
+                        static_cast<unsigned long long>(best.cycles),
+                        static_cast<unsigned long long>(best.instructions), best.kcycles_per_sec(),
+                        best.instructions_per_sec(), best.startup_ms);
+            results.push_back(best);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "simbench: " << e.what() << "\n";
+        return 2;
+    }
+
+    const long rss_kb = peak_rss_kb();
+    std::printf("peak RSS %ld kB\n", rss_kb);
+
+    if (!out_path.empty()) {
+        std::ofstream(out_path) << to_json(results, rss_kb);
+    }
+    if (!baseline_path.empty() && !compare_with_baseline(results, baseline_path, tolerance)) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+// The fixed set of programs used by simbench. Each one stresses a different part of
+// the model and leaves a checksum in a0 before halting, so a run can be validated
+// against the functional model.
+
+#include "rv32i_asm.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace workloads {
+
+using namespace rv32i;
+
+struct Workload {
+    std::string name;
+    std::vector<uint32_t> program;
+};
+
+// Long dependency chains through the ALU, with a little independent work on the side.
+inline std::vector<uint32_t> alu_chain(int32_t iterations) {
+    Assembler as;
+    as.li(s0, iterations);
+    as.li(a0, 1);
+    as.li(a1, 7);
+    as.label("loop");
+    as.add(a0, a0, a1);
+    as.xori(a0, a0, 0x5A);
+    as.slli(t0, a0, 3);
+    as.add(a0, a0, t0);
+    as.srli(t1, a0, 7);
+    as.xor_(a0, a0, t1);
+    as.addi(a1, a1, 3);
+    as.addi(s0, s0, -1);
+    as.bne(s0, zero, "loop");
+    as.halt();
+    return as.finish();
+}
+
+// Fills an array with stores, then repeatedly sums it with loads.
+inline std::vector<uint32_t> mem_stream(int32_t words, int32_t passes) {
+    Assembler as;
+    as.li(s1, 0x10000);          // array base
+    as.li(s2, words * 4);
+    as.add(s2, s2, s1);          // array end
+    as.mv(t0, s1);
+    as.li(t1, 1);
+    as.label("fill");
+    as.sw(t1, 0, t0);
+    as.addi(t1, t1, 5);
+    as.addi(t0, t0, 4);
+    as.bltu(t0, s2, "fill");
+    as.li(s0, passes);
+    as.li(a0, 0);
+    as.label("pass");
+    as.mv(t0, s1);
+    as.label("sum");
+    as.lw(t2, 0, t0);
+    as.add(a0, a0, t2);
+    as.sw(a0, 0, t0);
+    as.addi(t0, t0, 4);
+    as.bltu(t0, s2, "sum");
+    as.addi(s0, s0, -1);
+    as.bne(s0, zero, "pass");
+    as.halt();
+    return as.finish();
+}
+
+// Data-dependent branches driven by a xorshift generator.
+inline std::vector<uint32_t> branchy(int32_t iterations) {
+    Assembler as;
+    as.li(s0, iterations);
+    as.li(s1, 0x2545F491);       // generator state
+    as.li(a0, 0);
+    as.label("loop");
+    as.slli(t0, s1, 13);
+    as.xor_(s1, s1, t0);
+    as.srli(t0, s1, 17);
+    as.xor_(s1, s1, t0);
+    as.slli(t0, s1, 5);
+    as.xor_(s1, s1, t0);
+    as.andi(t1, s1, 1);
+    as.beq(t1, zero, "even");
+    as.addi(a0, a0, 3);
+    as.j("next");
+    as.label("even");
+    as.andi(t2, s1, 6);
+    as.bne(t2, zero, "next");
+    as.xori(a0, a0, 0x11);
+    as.label("next");
+    as.addi(s0, s0, -1);
+    as.bne(s0, zero, "loop");
+    as.halt();
+    return as.finish();
+}
+
+// Recursive Fibonacci: deep call/return chains and stack traffic.
+inline std::vector<uint32_t> calls(int32_t n) {
+    Assembler as;
+    as.li(sp, 0x80000);
+    as.li(a0, n);
+    as.call("fib");
+    as.j("done");
+
+    as.label("fib");             // a0 = fib(a0)
+    as.li(t0, 2);
+    as.blt(a0, t0, "fib_ret");
+    as.addi(sp, sp, -12);
+    as.sw(ra, 8, sp);
+    as.sw(s0, 4, sp);
+    as.sw(s1, 0, sp);
+    as.mv(s0, a0);
+    as.addi(a0, s0, -1);
+    as.call("fib");
+    as.mv(s1, a0);
+    as.addi(a0, s0, -2);
+    as.call("fib");
+    as.add(a0, a0, s1);
+    as.lw(s1, 0, sp);
+    as.lw(s0, 4, sp);
+    as.lw(ra, 8, sp);
+    as.addi(sp, sp, 12);
+    as.label("fib_ret");
+    as.ret();
+
+    as.label("done");
+    as.halt();
+    return as.finish();
+}
+
+inline std::vector<Workload> standard_set() {
+    return {
+        {"alu_chain", alu_chain(20000)},
+        {"mem_stream", mem_stream(1024, 12)},
+        {"branchy", branchy(15000)},
+        {"calls", calls(18)},
+    };
+}
+
+} // namespace workloads
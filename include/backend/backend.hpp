@@ -37,7 +37,10 @@ public:
 
         Channel<BranchResult>& branch_unit_to_control_c,
 
-        Bus<ROBEntry>& commit_bus
+        Bus<ROBEntry>& commit_bus,
+
+        HandshakeChannel<PCType>& icache_refill_c,
+        Channel<PCType>& icache_fill_c
     ) :
         alu_rs_to_alu_c(),
         branch_rs_to_branch_unit_c(),
@@ -48,13 +51,15 @@ public:
             cdb,
             control_to_alu_rs_c,     
             alu_rs_to_alu_c,        
-            global_flush_bus
+            global_flush_bus,
+            "alu_rs"
         ),
         branch_rs(
             cdb,
             control_to_branch_rs_c,     
             branch_rs_to_branch_unit_c,
-            global_flush_bus
+            global_flush_bus,
+            "branch_rs"
         ),
         alu(
             alu_rs_to_alu_c,        
@@ -72,7 +77,9 @@ public:
             cdb,
             control_to_mem_rs_c,     
             commit_bus,               
-            global_flush_bus
+            global_flush_bus,
+            icache_refill_c,
+            icache_fill_c
         )
     {
         cdb.connect(alu_to_cdb_c);
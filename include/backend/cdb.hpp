@@ -23,7 +23,7 @@ public:
         in_channels.push_back(&in_bus);
     }
 
-    std::optional<CDBResult> get(){
+    const CDBResult* get() const {
         return out_bus.get();
     }
 
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "backend/cdb.hpp"
+#include "instruction.hpp"
+#include "logger.hpp"
+#include "utils/clock.hpp"
+#include "utils/hive.hpp"
+#include "utils/stats.hpp"
+#include "utils/tagmatch.hpp"
+
+#include <array>
+#include <bit>
+#include <optional>
+#include <string>
+
+// --- Select Policies ---
+// A policy picks one slot out of the ready mask. `age` holds a per-slot sequence
+// number assigned at insertion; smaller is older.
+
+// Issues the ready instruction that entered the station first.
+struct OldestFirst {
+  template <size_t WORDS, size_t N>
+  static std::optional<size_t> pick(const std::array<uint64_t, WORDS>& ready,
+                                    const std::array<uint64_t, N>& age) {
+    std::optional<size_t> best;
+    for (size_t w = 0; w < WORDS; ++w) {
+      for (uint64_t bits = ready[w]; bits; bits &= bits - 1) {
+        size_t slot = w * 64 + std::countr_zero(bits);
+        if (!best || age[slot] < age[*best]) {
+          best = slot;
+        }
+      }
+    }
+    return best;
+  }
+};
+
+// Issues the ready instruction in the lowest hive slot, ignoring age.
+struct SlotOrder {
+  template <size_t WORDS, size_t N>
+  static std::optional<size_t> pick(const std::array<uint64_t, WORDS>& ready,
+                                    const std::array<uint64_t, N>&) {
+    for (size_t w = 0; w < WORDS; ++w) {
+      if (ready[w]) {
+        return w * 64 + std::countr_zero(ready[w]);
+      }
+    }
+    return std::nullopt;
+  }
+};
+
+/**
+ * @class IssueBuffer
+ * @brief The waiting instructions of a reservation station, with wakeup and select.
+ *
+ * Instructions live in a hive; their source tags are mirrored into two TagArrays indexed
+ * by hive slot, so a CDB broadcast and the readiness check are a few vector compares
+ * and mask operations instead of a walk over every FilledInstruction.
+ *
+ * Counters (prefixed with the station name): `issued`, `ready_wait_cycles` (cycles
+ * between an instruction's operands becoming available and its issue, summed),
+ * `ready_waited` (issues that waited at least one cycle) and `ready_wait_max`.
+ */
+template <size_t N, typename SelectPolicy = OldestFirst>
+class IssueBuffer {
+  using Mask = typename TagArray<N>::Mask;
+
+  hive<FilledInstruction, N> entries;
+  TagArray<N> q_rs1;
+  TagArray<N> q_rs2;
+  std::array<uint64_t, N> age{};
+  std::array<uint64_t, N> ready_since{};
+  uint64_t next_age = 0;
+
+  uint64_t& issued_count;
+  uint64_t& wait_cycles;
+  uint64_t& waited_count;
+  uint64_t& wait_max;
+
+  static uint64_t now() { return Clock::getInstance().getTime(); }
+
+public:
+  explicit IssueBuffer(const std::string& name)
+      : issued_count(Stats::getInstance().counter(name + ".issued")),
+        wait_cycles(Stats::getInstance().counter(name + ".ready_wait_cycles")),
+        waited_count(Stats::getInstance().counter(name + ".ready_waited")),
+        wait_max(Stats::getInstance().counter(name + ".ready_wait_max")) {}
+
+  bool empty() const { return entries.empty(); }
+  bool full() const { return entries.full(); }
+  void clear() { entries.clear(); }
+
+  const FilledInstruction& operator[](size_t slot) const { return entries[slot]; }
+
+  void insert(const FilledInstruction& ins) {
+    if (auto it = entries.insert(ins)) {
+      size_t slot = it->slot();
+      q_rs1.set(slot, ins.q_rs1);
+      q_rs2.set(slot, ins.q_rs2);
+      age[slot] = next_age++;
+      ready_since[slot] = now();
+    }
+  }
+
+  // Removes an issued instruction and records how long it sat ready.
+  void erase(size_t slot) {
+    uint64_t wait = now() - ready_since[slot];
+    ++issued_count;
+    wait_cycles += wait;
+    waited_count += wait != 0;
+    if (wait > wait_max) {
+      wait_max = wait;
+    }
+    entries.erase_slot(slot);
+  }
+
+  // Captures a broadcast value in every operand waiting on it. Tag 0 marks a ready
+  // operand, so a result for ROB id 0 must not match anything.
+  void wakeup(const CDBResult& result) {
+    if (result.rob_id == 0) {
+      return;
+    }
+    const Mask& occupied = entries.occupancy();
+    Mask m1 = q_rs1.match(result.rob_id);
+    Mask m2 = q_rs2.match(result.rob_id);
+    for (size_t w = 0; w < Mask{}.size(); ++w) {
+      for (uint64_t bits = m1[w] & occupied[w]; bits; bits &= bits - 1) {
+        size_t slot = w * 64 + std::countr_zero(bits);
+        FilledInstruction& ins = entries[slot];
+        logger.With("UpdatedROB_ID", ins.id)
+              .With("Operand", "rs1")
+              .With("SourceROB_ID", result.rob_id)
+              .Info("Updating operand from CDB");
+        ins.v_rs1 = result.data;
+        ins.q_rs1 = 0;
+        q_rs1.set(slot, 0);
+        ready_since[slot] = now();
+      }
+      for (uint64_t bits = m2[w] & occupied[w]; bits; bits &= bits - 1) {
+        size_t slot = w * 64 + std::countr_zero(bits);
+        FilledInstruction& ins = entries[slot];
+        logger.With("UpdatedROB_ID", ins.id)
+              .With("Operand", "rs2")
+              .With("SourceROB_ID", result.rob_id)
+              .Info("Updating operand from CDB");
+        ins.v_rs2 = result.data;
+        ins.q_rs2 = 0;
+        q_rs2.set(slot, 0);
+        ready_since[slot] = now();
+      }
+    }
+  }
+
+  // One bit per slot whose operands are all available.
+  Mask ready() const {
+    const Mask& occupied = entries.occupancy();
+    Mask r1 = q_rs1.match(0);
+    Mask r2 = q_rs2.match(0);
+    Mask mask;
+    for (size_t w = 0; w < mask.size(); ++w) {
+      mask[w] = r1[w] & r2[w] & occupied[w];
+    }
+    return mask;
+  }
+
+  // Slot of the ready instruction the policy issues next.
+  std::optional<size_t> select() const {
+    return SelectPolicy::pick(ready(), age);
+  }
+};
@@ -30,10 +30,12 @@ public:
         CommonDataBus& cdb,
         Channel<FilledInstruction>& mem_instr_in_c,
         Bus<ROBEntry>& commit_bus,
-        Bus<bool>& global_flush_bus
-    ) : memory(unified_memory, mob_to_mem_req_c, mem_read_response_c, global_flush_bus), // Pass it to Memory
+        Bus<bool>& global_flush_bus,
+        HandshakeChannel<PCType>& icache_refill_c,
+        Channel<PCType>& icache_fill_c
+    ) : memory(unified_memory, mob_to_mem_req_c, mem_read_response_c, icache_refill_c, icache_fill_c, global_flush_bus), // Pass it to Memory
         mob(rs_to_mob_mark_c, mrs_to_mob_fill_c, mob_to_mem_req_c, mob_write_commit_c, commit_bus, global_flush_bus),
-        memory_rs(cdb, mem_instr_in_c, mrs_to_mob_fill_c, rs_to_mob_mark_c, global_flush_bus), mob_to_mem_req_c() {
+        memory_rs(cdb, mem_instr_in_c, mrs_to_mob_fill_c, rs_to_mob_mark_c, global_flush_bus, "mem_rs"), mob_to_mem_req_c() {
         cdb.connect(mem_read_response_c);
         cdb.connect(mob_write_commit_c);
     }
@@ -27,23 +27,34 @@ struct MemoryRequest {
   }
 };
 
+// One port shared by the MOB's data requests and the I-cache's line refills, data first.
+// A refill answers with the line address once REFILL_LATENCY cycles have passed; a flush
+// does not cancel it.
 class Memory {
   std::array<std::byte, MEMORY_SIZE>& memory;
   int time_cnt = 0;
   MemoryRequest request;
+  bool refilling = false;
+  PCType refill_line = 0;
 
   HandshakeChannel<MemoryRequest>& request_c;
   Channel<CDBResult>& response_c;
+  HandshakeChannel<PCType>& refill_c;
+  Channel<PCType>& fill_c;
   Bus<bool>& global_flush_bus;
 
 public:
   Memory(std::array<std::byte, MEMORY_SIZE>& unified_memory,
          HandshakeChannel<MemoryRequest>& req_channel,
          Channel<CDBResult>& resp_channel,
+         HandshakeChannel<PCType>& refill_channel,
+         Channel<PCType>& fill_channel,
          Bus<bool>& flush_bus)
       : memory(unified_memory),
         request_c(req_channel),
         response_c(resp_channel),
+        refill_c(refill_channel),
+        fill_c(fill_channel),
         global_flush_bus(flush_bus) {
     Clock::getInstance().subscribe([this] { this->tick(); });
   }
@@ -52,11 +63,16 @@ public:
     if(time_cnt==0) {
       if(auto result = request_c.receive()) {
         request = *result;
-        time_cnt=3;
+        refilling = false;
+        time_cnt=MEMORY_LATENCY;
+      } else if(auto line = refill_c.receive()) {
+        refill_line = *line;
+        refilling = true;
+        time_cnt=REFILL_LATENCY;
       }
     }
     if(global_flush_bus.get()) {
-      if(time_cnt>0 && request.type==READ) {
+      if(time_cnt>0 && !refilling && request.type==READ) {
         time_cnt=0;
       }
     }
@@ -65,12 +81,20 @@ public:
     }
     if(time_cnt==0) {
       request_c.ready();
+      refill_c.ready();
     }
   }
 
 private:
   void process_completed_request() {
-    if (request.type == READ) {
+    if (refilling) {
+      if (!fill_c.can_send()) {
+        time_cnt++; // Stall
+        return;
+      }
+      fill_c.send(refill_line);
+      logger.With("Line", refill_line).Info("I-cache line refilled");
+    } else if (request.type == READ) {
       if (!response_c.can_send()) {
         time_cnt++; // Stall
         return;
@@ -22,6 +22,8 @@ struct MOBEntry {
 
 class MemoryOrderBuffer {
   queue<MOBEntry, LSB_SIZE> buffer;
+  // Commit is in order, so committed stores are always the oldest entries.
+  size_t committed_count = 0;
 
   Channel<std::pair<RobIDType, MemoryRequestType>> &mark_in_c;
   Channel<FilledInstruction> &fill_in_c;
@@ -51,8 +53,9 @@ public:
     auto commit_result = commit_bus.get();
     if (commit_result) {
       for (size_t i = 0; i < buffer.size(); ++i) {
-        if (buffer[i].req.rob_id == commit_result->id) {
+        if (buffer[i].req.rob_id == commit_result->id && !buffer[i].committed) {
           buffer[i].committed = true;
+          ++committed_count;
           logger.With("ROB_ID", commit_result->id)
               .Info("MOBEntry marked as committed");
         }
@@ -60,9 +63,8 @@ public:
     }
     
     if (global_flush_bus.get()) {
-      while (!buffer.empty() && !buffer.back().committed) {
-          buffer.pop_back();
-      }
+      // Committed stores form the oldest part of the buffer; drop everything after them.
+      buffer.truncate(committed_count);
       for (size_t i = 0; i < buffer.size(); ++i) {
         logger.With("ROB_ID", buffer[i].req.rob_id)
         .Info("MOBEntry not flushed because it is committed.");
@@ -79,9 +81,9 @@ public:
     if (!buffer.full()) {
       auto mark_result = mark_in_c.receive();
       if (mark_result) {
-        auto [rob_id, type] = mark_result.value();
+        auto [rob_id, type] = *mark_result;
         // Placeholder
-        buffer.push_back(MOBEntry{MemoryRequest{type, false, rob_id, 0, 0, {}},
+        buffer.unchecked_push_back(MOBEntry{MemoryRequest{type, false, rob_id, 0, 0, {}},
                                  false, false});
         logger.With("ROB_ID", rob_id)
             .With("Type", type == MemoryRequestType::READ ? "READ" : "WRITE")
@@ -92,7 +94,7 @@ public:
     // Fill data if ready
     auto fill_result = fill_in_c.peek();
     if (fill_result) {
-      const auto &filled_ins = fill_result.value();
+      const auto &filled_ins = *fill_result;
       auto mem_req_opt = translate_to_memory_request(filled_ins);
       if (mem_req_opt) {
         const auto &new_req = mem_req_opt.value();
@@ -126,7 +128,7 @@ public:
     
 
     if (!buffer.empty()) {
-      MOBEntry &entry = buffer.front();
+      MOBEntry &entry = buffer.unchecked_front();
       if (entry.ready && (entry.req.type == READ || entry.committed)) {
         if (mem_request_out_c.can_send()) {
           mem_request_out_c.send(entry.req);
@@ -135,7 +137,8 @@ public:
                                                                       : "WRITE")
               .With("Addr", entry.req.address)
               .Info("Sending memory request to Memory Unit");
-          buffer.pop_front();
+          committed_count -= entry.committed;
+          buffer.unchecked_pop_front();
         }
       }
     }
@@ -146,40 +149,16 @@ public:
 
 inline std::optional<MemoryRequest>
 translate_to_memory_request(const FilledInstruction &filled_ins) {
-  if (!is_mem(filled_ins.ins.op)) {
-    return std::nullopt;
-  }
+  const OpTraits &t = op_traits(filled_ins.ins.op);
   const RegDataType address = filled_ins.v_rs1 + filled_ins.ins.imm;
-  switch (filled_ins.ins.op) {
-  case OpType::LW: // Load Word (32-bit, signed)
-    return MemoryRequest::CreateReadRequest(filled_ins.id, address, 4, true);
-
-  case OpType::LH: // Load Half-word (16-bit, signed)
-    return MemoryRequest::CreateReadRequest(filled_ins.id, address, 2, true);
-
-  case OpType::LHU: // Load Half-word Unsigned (16-bit, unsigned)
-    return MemoryRequest::CreateReadRequest(filled_ins.id, address, 2, false);
-
-  case OpType::LB: // Load Byte (8-bit, signed)
-    return MemoryRequest::CreateReadRequest(filled_ins.id, address, 1, true);
-
-  case OpType::LBU: // Load Byte Unsigned (8-bit, unsigned)
-    return MemoryRequest::CreateReadRequest(filled_ins.id, address, 1, false);
-  // --- Store Instructions (WRITE) ---
-  case OpType::SW: // Store Word (32-bit)
+  if (t.is_load) {
+    return MemoryRequest::CreateReadRequest(filled_ins.id, address, t.mem_size,
+                                            t.is_signed);
+  }
+  if (t.is_store) {
     // The data to be stored is in the second source register (v_rs2).
-    return MemoryRequest::CreateWriteRequest(filled_ins.id, address, 4,
-                                             filled_ins.v_rs2);
-
-  case OpType::SH: // Store Half-word (16-bit)
-    return MemoryRequest::CreateWriteRequest(filled_ins.id, address, 2,
+    return MemoryRequest::CreateWriteRequest(filled_ins.id, address, t.mem_size,
                                              filled_ins.v_rs2);
-
-  case OpType::SB: // Store Byte (8-bit)
-    return MemoryRequest::CreateWriteRequest(filled_ins.id, address, 1,
-                                             filled_ins.v_rs2);
-
-  default:
-    return std::nullopt;
   }
+  return std::nullopt;
 }
@@ -2,33 +2,23 @@
 
 #include "backend/cdb.hpp"
 #include "backend/memsys/memory.hpp"
-#include "utils/hive.hpp"
+#include "backend/issue_buffer.hpp"
 #include "utils/bus.hpp"
 #include "instruction.hpp" 
 #include <optional>        
 #include "logger.hpp"
 
 inline std::optional<MemoryRequestType> get_mem_req_type(OpType op) {
-    switch (op) {
-        case OpType::LW:
-        case OpType::LH:
-        case OpType::LHU:
-        case OpType::LB:
-        case OpType::LBU:
-            return MemoryRequestType::READ;
-        case OpType::SW:
-        case OpType::SH:
-        case OpType::SB:
-            return MemoryRequestType::WRITE;
-        default:
-            return std::nullopt;
-    }
+    const OpTraits& t = op_traits(op);
+    if (t.is_load) return MemoryRequestType::READ;
+    if (t.is_store) return MemoryRequestType::WRITE;
+    return std::nullopt;
 }
 
 
-template <size_t BufferSize>
+template <size_t BufferSize, typename SelectPolicy = OldestFirst>
 class MemoryReservationStation {
-  hive<FilledInstruction, BufferSize> buffer;
+  IssueBuffer<BufferSize, SelectPolicy> buffer;
 
   //input
   CommonDataBus& cdb;
@@ -44,8 +34,10 @@ public:
                            Channel<FilledInstruction>& ins_channel,
                            Channel<FilledInstruction>& exec_channel,
                            Channel<std::pair<RobIDType, MemoryRequestType>>& mob_mark_channel,
-                           Bus<bool>& global_flush_bus)
-      : cdb(cdb),
+                           Bus<bool>& global_flush_bus,
+                           const std::string& name)
+      : buffer(name),
+        cdb(cdb),
         ins_in_c(ins_channel),
         exec_out_c(exec_channel),
         mob_mark_out_c(mob_mark_channel),
@@ -86,34 +78,14 @@ public:
       logger.With("SourceROB_ID", cdb_result->rob_id)
             .With("Value", cdb_result->data)
             .Info("MemoryReservationStation received CDB broadcast");
-      for (auto it = buffer.begin(); it != buffer.end(); ++it) {
-        if (it->q_rs1 != 0 && it->q_rs1 == cdb_result->rob_id) {
-          logger.With("UpdatedROB_ID", it->id)
-                .With("Operand", "rs1")
-                .With("SourceROB_ID", cdb_result->rob_id)
-                .Info("Updating operand from CDB");
-          it->v_rs1 = cdb_result->data;
-          it->q_rs1 = 0;
-        }
-        if (it->q_rs2 != 0 && it->q_rs2 == cdb_result->rob_id) {
-          logger.With("UpdatedROB_ID", it->id)
-                .With("Operand", "rs2")
-                .With("SourceROB_ID", cdb_result->rob_id)
-                .Info("Updating operand from CDB");
-          it->v_rs2 = cdb_result->data;
-          it->q_rs2 = 0;
-        }
-      }
+      buffer.wakeup(*cdb_result);
     }
-    for (auto it = buffer.begin(); it != buffer.end(); ++it) {
-      if (it->q_rs1 == 0 && it->q_rs2 == 0) {
-        if (exec_out_c.can_send()) {
-          logger.With("ROB_ID", it->id)
-                .Info("Dispatching instruction from MemoryReservationStation to execution unit");
-          exec_out_c.send(*it);
-          it = buffer.erase(it);
-          break;
-        }
+    if (exec_out_c.can_send()) {
+      if (auto slot = buffer.select()) {
+        logger.With("ROB_ID", buffer[*slot].id)
+              .Info("Dispatching instruction from MemoryReservationStation to execution unit");
+        exec_out_c.send(buffer[*slot]);
+        buffer.erase(*slot);
       }
     }
   }
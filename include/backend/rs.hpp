@@ -2,13 +2,13 @@
 
 #include "backend/cdb.hpp"
 #include "middlend/control.hpp"
-#include "utils/hive.hpp"
+#include "backend/issue_buffer.hpp"
 #include "utils/bus.hpp"
 #include "logger.hpp"
 
-template <size_t BufferSize>
+template <size_t BufferSize, typename SelectPolicy = OldestFirst>
 class ReservationStation {
-  hive<FilledInstruction, BufferSize> buffer;
+  IssueBuffer<BufferSize, SelectPolicy> buffer;
 
   //input
   CommonDataBus& cdb;
@@ -22,8 +22,10 @@ public:
   ReservationStation(CommonDataBus& cdb,
                      Channel<FilledInstruction>& ins_channel,
                      Channel<FilledInstruction>& exec_channel,
-                     Bus<bool>& global_flush_bus)
-      : cdb(cdb),
+                     Bus<bool>& global_flush_bus,
+                     const std::string& name)
+      : buffer(name),
+        cdb(cdb),
         ins_in_c(ins_channel),
         exec_out_c(exec_channel),
         global_flush_bus(global_flush_bus) {
@@ -52,34 +54,14 @@ public:
       logger.With("SourceROB_ID", cdb_result->rob_id)
             .With("Value", cdb_result->data)
             .Info("ReservationStation received CDB broadcast");
-      for (auto it = buffer.begin(); it != buffer.end(); ++it) {
-        if (it->q_rs1 != 0 && it->q_rs1 == cdb_result->rob_id) {
-          logger.With("UpdatedROB_ID", it->id)
-                .With("Operand", "rs1")
-                .With("SourceROB_ID", cdb_result->rob_id)
-                .Info("Updating operand from CDB");
-          it->v_rs1 = cdb_result->data;
-          it->q_rs1 = 0;
-        }
-        if (it->q_rs2 != 0 && it->q_rs2 == cdb_result->rob_id) {
-          logger.With("UpdatedROB_ID", it->id)
-                .With("Operand", "rs2")
-                .With("SourceROB_ID", cdb_result->rob_id)
-                .Info("Updating operand from CDB");
-          it->v_rs2 = cdb_result->data;
-          it->q_rs2 = 0;
-        }
-      }
+      buffer.wakeup(*cdb_result);
     }
-    for (auto it = buffer.begin(); it != buffer.end(); ++it) {
-      if (it->q_rs1 == 0 && it->q_rs2 == 0) {
-        if (exec_out_c.can_send()) {
-          logger.With("ROB_ID", it->id)
-                .Info("Dispatching instruction from ReservationStation to execution unit");
-          exec_out_c.send(*it);
-          it = buffer.erase(it);
-          break;
-        }
+    if (exec_out_c.can_send()) {
+      if (auto slot = buffer.select()) {
+        logger.With("ROB_ID", buffer[*slot].id)
+              .Info("Dispatching instruction from ReservationStation to execution unit");
+        exec_out_c.send(buffer[*slot]);
+        buffer.erase(*slot);
       }
     }
   }
@@ -44,7 +44,7 @@ private:
       case OpType::SLTI:  return (static_cast<int32_t>(v_rs1) < imm) ? 1 : 0;
       case OpType::SLTIU: return (static_cast<uint32_t>(v_rs1) < imm) ? 1 : 0;
 
-      case OpType::AUIPC: return v_rs1 + imm;
+      case OpType::AUIPC: return ins.pc + imm;
       case OpType::LUI:   return imm;
 
       default:
@@ -65,7 +65,7 @@ private:
         target_pc = pc + imm;
         break;
       case OpType::JALR:
-        target_pc = (v_rs1 + imm);
+        target_pc = (v_rs1 + imm) & ~PCType{1};
         break;
       default:
         logger.With("Type", to_string(ins.op)).Warn("BranchUnit received non-branch instruction.");
@@ -100,7 +100,8 @@ public:
     }
 
     const FilledInstruction& instr = *ins_peek;
-    bool needs_cdb = (instr.ins.op == OpType::JAL || instr.ins.op == OpType::JALR);
+    // Jumps with rd == x0 and plain branches are made ready by their branch result alone.
+    bool needs_cdb = writes_register(instr.ins);
     bool can_send_branch_result = branch_result_out_c.can_send();
     bool can_send_cdb_result = needs_cdb ? cdb_out_c.can_send() : true;
 
@@ -119,12 +120,17 @@ public:
             .Info("BranchUnit sent branch result.");
 
       if (needs_cdb) {
-        RegDataType link_address = instr.ins.pc + 4;
-        CDBResult cdb_res = {instr.id, link_address};
+        RegDataType value = fallthrough_pc(instr.ins.pc, instr.ins.compressed);
+        if (is_conditional_branch(instr.ins.op)) {
+          // BLT[U] came from bnez, BGE[U] from beqz: rd is 1 exactly when a < b.
+          const bool less_than_branch = instr.ins.op == OpType::BLT || instr.ins.op == OpType::BLTU;
+          value = branch_res.is_taken == less_than_branch;
+        }
+        CDBResult cdb_res = {instr.id, value};
         cdb_out_c.send(cdb_res);
         logger.With("ROB_ID", cdb_res.rob_id)
-              .With("LinkAddr", cdb_res.data)
-              .Info("BranchUnit (JAL/JALR) sent link address to its CDB channel.");
+              .With("Value", cdb_res.data)
+              .Info("BranchUnit sent its rd value to its CDB channel.");
       }
     }
   }
@@ -7,8 +7,9 @@ using RegIDType = uint8_t;
 using RegDataType = uint32_t;
 using WordType = uint32_t;
 
-// 0 is left for unused
-using RobIDType = uint32_t; // for simplicity to avoid considering circular situations
+// 0 is left for unused. IDs are allocated consecutively and wrap around; the bits above
+// the ROB index act as a generation count, and ROB lookups compare the full id.
+using RobIDType = uint16_t;
 
 
 using MemAddrType = uint32_t;
@@ -17,17 +18,44 @@ using ImmType = uint16_t;
 using PCType = uint32_t;
 
 constexpr size_t MEMORY_SIZE = 1024 * 1024;
-constexpr size_t CACHE_LINE_SIZE = 8;
-constexpr size_t BANDWIDTH = 8;
+constexpr size_t CACHE_LINE_SIZE = 32;
+
+// Fetch reads one aligned FETCH_BLOCK_BYTES block per cycle, from the PC to the block end
+// or a predicted-taken branch: FETCH_WIDTH RV32I instructions, or up to twice as many
+// compressed ones. A 32-bit instruction may straddle two blocks.
+constexpr size_t FETCH_WIDTH = 4;
+constexpr size_t FETCH_BLOCK_BYTES = FETCH_WIDTH * 4;
+constexpr size_t FETCH_BLOCK_MAX_INSTRUCTIONS = FETCH_BLOCK_BYTES / 2;
+static_assert(CACHE_LINE_SIZE % FETCH_BLOCK_BYTES == 0, "a fetch block must not span two cache lines");
 constexpr size_t MEMORY_LATENCY = 3;
+// A line refill returns one word per cycle after the first.
+constexpr size_t REFILL_LATENCY = MEMORY_LATENCY + CACHE_LINE_SIZE / sizeof(WordType) - 1;
+
+// Instruction cache. A hit hands the fetch block to decode ICACHE_HIT_LATENCY cycles
+// after fetch takes the request (1: the next cycle); hits are pipelined.
+constexpr size_t ICACHE_SIZE = 4096;
+constexpr size_t ICACHE_WAYS = 2;
+constexpr size_t ICACHE_HIT_LATENCY = 1;
+constexpr size_t ICACHE_MSHRS = 4;
+
+// Fetch requests PCLogic may run ahead of fetch, and fetched blocks waiting for decode.
+constexpr size_t FTQ_SIZE = 8;
+constexpr size_t IBUF_SIZE = 4;
 
 constexpr RobIDType REG_SIZE = 32;
 
 constexpr size_t ROB_SIZE = 32;
+static_assert(ROB_SIZE < (size_t{1} << (8 * sizeof(RobIDType) - 1)),
+              "ROB ids must stay unique across the entries in flight");
 
 constexpr size_t LSB_SIZE = 32;
 
 
 constexpr size_t RS_MEM_SIZE = 32;
 constexpr size_t RS_ALU_SIZE = 32;
-constexpr size_t RS_BRANCH_SIZE = 32;
\ No newline at end of file
+constexpr size_t RS_BRANCH_SIZE = 32;
+
+constexpr size_t BTB_SETS = 128;
+constexpr size_t BTB_WAYS = 4;
+constexpr size_t RAS_SIZE = 16;
+constexpr size_t INDIRECT_TABLE_SIZE = 256;
\ No newline at end of file
@@ -0,0 +1,352 @@
+#pragma once
+
+#include "constants.hpp"
+#include "utils/ints.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Architectural effect of a single retired instruction.
+ */
+struct RetireRecord {
+    PCType pc = 0;
+    uint32_t word = 0;
+    RegIDType rd = 0;       // 0 if the instruction does not write a register
+    RegDataType value = 0;  // value written to rd (meaningless if rd == 0)
+};
+
+/**
+ * @class FunctionalModel
+ * @brief A minimal in-order RV32IC instruction set simulator.
+ *
+ * @details Executes one instruction per step() directly on its own copy of memory.
+ * It shares no decode or execute logic with the pipeline on purpose, so that it can
+ * serve as an independent reference for lockstep co-simulation.
+ */
+class FunctionalModel {
+    std::vector<std::byte> memory;
+    std::array<RegDataType, REG_SIZE> regs{};
+    PCType pc = 0;
+
+public:
+    explicit FunctionalModel(const std::vector<std::byte>& initial_memory_image)
+        : memory(MEMORY_SIZE) {
+        std::copy_n(initial_memory_image.begin(),
+                    std::min(initial_memory_image.size(), memory.size()),
+                    memory.begin());
+    }
+
+    PCType get_pc() const { return pc; }
+    const std::array<RegDataType, REG_SIZE>& get_regs() const { return regs; }
+
+    // The instruction at `addr`: its 16 bits if it is compressed, else all 32.
+    uint32_t fetch(PCType addr) const {
+        const uint32_t low = load(addr, 2, false);
+        return (low & 0b11) != 0b11 ? low : load(addr, 4, false);
+    }
+
+    /**
+     * @brief Executes the instruction at the current PC.
+     * @return The architectural effect of the instruction.
+     * @throws std::runtime_error on an illegal instruction or an out-of-bounds access.
+     */
+    RetireRecord step() {
+        RetireRecord rec;
+        rec.pc = pc;
+        rec.word = fetch(pc);
+        if ((rec.word & 0b11) != 0b11) {
+            step_compressed(rec);
+            return rec;
+        }
+
+        const uint32_t inst = rec.word;
+        const uint32_t opcode = inst & 0x7F;
+        const uint32_t rd = (inst >> 7) & 0x1F;
+        const uint32_t funct3 = (inst >> 12) & 0x7;
+        const uint32_t rs1 = (inst >> 15) & 0x1F;
+        const uint32_t rs2 = (inst >> 20) & 0x1F;
+        const uint32_t funct7 = (inst >> 25) & 0x7F;
+
+        const uint32_t a = regs[rs1];
+        const uint32_t b = regs[rs2];
+        const int32_t imm_i = static_cast<int32_t>(inst) >> 20;
+        const int32_t imm_s = (static_cast<int32_t>(inst & 0xFE000000) >> 20) | ((inst >> 7) & 0x1F);
+        const int32_t imm_b = (static_cast<int32_t>(inst & 0x80000000) >> 19) | ((inst & 0x80) << 4) |
+                              ((inst >> 20) & 0x7E0) | ((inst >> 7) & 0x1E);
+        const int32_t imm_j = (static_cast<int32_t>(inst & 0x80000000) >> 11) | (inst & 0xFF000) |
+                              ((inst >> 9) & 0x800) | ((inst >> 20) & 0x7FE);
+
+        PCType next_pc = pc + 4;
+        bool writes = true;
+        uint32_t result = 0;
+
+        switch (opcode) {
+        case 0b0110111: result = inst & 0xFFFFF000; break;        // LUI
+        case 0b0010111: result = pc + (inst & 0xFFFFF000); break; // AUIPC
+        case 0b1101111:                                           // JAL
+            result = pc + 4;
+            next_pc = pc + imm_j;
+            break;
+        case 0b1100111:                                           // JALR
+            result = pc + 4;
+            next_pc = (a + imm_i) & ~1u;
+            break;
+        case 0b1100011: {                                         // Branches
+            writes = false;
+            bool taken;
+            switch (funct3) {
+            case 0b000: taken = a == b; break;
+            case 0b001: taken = a != b; break;
+            case 0b100: taken = static_cast<int32_t>(a) < static_cast<int32_t>(b); break;
+            case 0b101: taken = static_cast<int32_t>(a) >= static_cast<int32_t>(b); break;
+            case 0b110: taken = a < b; break;
+            case 0b111: taken = a >= b; break;
+            default: illegal(inst);
+            }
+            if (taken) next_pc = pc + imm_b;
+            break;
+        }
+        case 0b0000011: {                                         // Loads
+            const uint32_t addr = a + imm_i;
+            switch (funct3) {
+            case 0b000: result = load(addr, 1, true); break;
+            case 0b001: result = load(addr, 2, true); break;
+            case 0b010: result = load(addr, 4, false); break;
+            case 0b100: result = load(addr, 1, false); break;
+            case 0b101: result = load(addr, 2, false); break;
+            default: illegal(inst);
+            }
+            break;
+        }
+        case 0b0100011: {                                         // Stores
+            writes = false;
+            const uint32_t addr = a + imm_s;
+            switch (funct3) {
+            case 0b000: store(addr, 1, b); break;
+            case 0b001: store(addr, 2, b); break;
+            case 0b010: store(addr, 4, b); break;
+            default: illegal(inst);
+            }
+            break;
+        }
+        case 0b0010011: {                                         // ALU immediate
+            const uint32_t shamt = rs2;
+            switch (funct3) {
+            case 0b000: result = a + imm_i; break;
+            case 0b010: result = static_cast<int32_t>(a) < imm_i; break;
+            case 0b011: result = a < static_cast<uint32_t>(imm_i); break;
+            case 0b100: result = a ^ imm_i; break;
+            case 0b110: result = a | imm_i; break;
+            case 0b111: result = a & imm_i; break;
+            case 0b001: result = a << shamt; break;
+            case 0b101:
+                result = (funct7 & 0x20) ? static_cast<uint32_t>(static_cast<int32_t>(a) >> shamt)
+                                         : a >> shamt;
+                break;
+            }
+            break;
+        }
+        case 0b0110011: {                                         // ALU register
+            const bool alt = funct7 & 0x20;
+            switch (funct3) {
+            case 0b000: result = alt ? a - b : a + b; break;
+            case 0b001: result = a << (b & 0x1F); break;
+            case 0b010: result = static_cast<int32_t>(a) < static_cast<int32_t>(b); break;
+            case 0b011: result = a < b; break;
+            case 0b100: result = a ^ b; break;
+            case 0b101:
+                result = alt ? static_cast<uint32_t>(static_cast<int32_t>(a) >> (b & 0x1F))
+                             : a >> (b & 0x1F);
+                break;
+            case 0b110: result = a | b; break;
+            case 0b111: result = a & b; break;
+            }
+            break;
+        }
+        default:
+            illegal(inst);
+        }
+
+        if (writes && rd != 0) {
+            regs[rd] = result;
+            rec.rd = rd;
+            rec.value = result;
+        }
+        pc = next_pc;
+        return rec;
+    }
+
+private:
+    static uint32_t field(uint32_t v, int hi, int lo) { return (v >> lo) & ((1u << (hi - lo + 1)) - 1); }
+
+    static int32_t sign_extend(uint32_t v, int width) {
+        return static_cast<int32_t>(v << (32 - width)) >> (32 - width);
+    }
+
+    /**
+     * @brief Executes the RV32C instruction in `rec.word` and fills in the rest of `rec`.
+     * Compressed instructions are executed directly rather than expanded, so this does
+     * not share the decoder's expansion table either.
+     */
+    void step_compressed(RetireRecord& rec) {
+        const uint32_t c = rec.word;
+        const uint32_t funct3 = field(c, 15, 13);
+        const uint32_t r = field(c, 11, 7);           // rd/rs1 in the full register space
+        const uint32_t r2 = field(c, 6, 2);           // rs2 in the full register space
+        const uint32_t rp = 8 + field(c, 9, 7);       // rd'/rs1' (x8-x15)
+        const uint32_t rp2 = 8 + field(c, 4, 2);      // rd'/rs2' (x8-x15)
+        const int32_t imm6 = sign_extend(field(c, 12, 12) << 5 | field(c, 6, 2), 6);
+        const int32_t jump = sign_extend(field(c, 12, 12) << 11 | field(c, 8, 8) << 10 | field(c, 10, 9) << 8 |
+                                             field(c, 6, 6) << 7 | field(c, 7, 7) << 6 | field(c, 2, 2) << 5 |
+                                             field(c, 11, 11) << 4 | field(c, 5, 3) << 1,
+                                         12);
+        const uint32_t word_offset = field(c, 5, 5) << 6 | field(c, 12, 10) << 3 | field(c, 6, 6) << 2;
+
+        PCType next_pc = pc + 2;
+        uint32_t rd = 0;
+        uint32_t result = 0;
+
+        switch ((c & 0b11) << 3 | funct3) {
+        case 0b00'000: {                                          // C.ADDI4SPN
+            const uint32_t imm = field(c, 10, 7) << 6 | field(c, 12, 11) << 4 | field(c, 5, 5) << 3 |
+                                 field(c, 6, 6) << 2;
+            if (imm == 0) illegal(c);
+            rd = rp2;
+            result = regs[2] + imm;
+            break;
+        }
+        case 0b00'010:                                            // C.LW
+            rd = rp2;
+            result = load(regs[rp] + word_offset, 4, false);
+            break;
+        case 0b00'110:                                            // C.SW
+            store(regs[rp] + word_offset, 4, regs[rp2]);
+            break;
+        case 0b01'000:                                            // C.ADDI, C.NOP
+            rd = r;
+            result = regs[r] + imm6;
+            break;
+        case 0b01'001:                                            // C.JAL
+            rd = 1;
+            result = pc + 2;
+            next_pc = pc + jump;
+            break;
+        case 0b01'010:                                            // C.LI
+            rd = r;
+            result = imm6;
+            break;
+        case 0b01'011:
+            if (r == 2) {                                         // C.ADDI16SP
+                const int32_t imm = sign_extend(field(c, 12, 12) << 9 | field(c, 4, 3) << 7 | field(c, 5, 5) << 6 |
+                                                    field(c, 2, 2) << 5 | field(c, 6, 6) << 4,
+                                                10);
+                if (imm == 0) illegal(c);
+                rd = 2;
+                result = regs[2] + imm;
+            } else {                                              // C.LUI
+                if (imm6 == 0) illegal(c);
+                rd = r;
+                result = static_cast<uint32_t>(imm6) << 12;
+            }
+            break;
+        case 0b01'100: {
+            const uint32_t a = regs[rp];
+            const uint32_t b = regs[rp2];
+            const uint32_t shamt = field(c, 6, 2);
+            rd = rp;
+            switch (field(c, 11, 10)) {
+            case 0b00:                                            // C.SRLI
+                if (field(c, 12, 12)) illegal(c);
+                result = a >> shamt;
+                break;
+            case 0b01:                                            // C.SRAI
+                if (field(c, 12, 12)) illegal(c);
+                result = static_cast<uint32_t>(static_cast<int32_t>(a) >> shamt);
+                break;
+            case 0b10: result = a & imm6; break;                  // C.ANDI
+            default:
+                if (field(c, 12, 12)) illegal(c);
+                switch (field(c, 6, 5)) {
+                case 0b00: result = a - b; break;                 // C.SUB
+                case 0b01: result = a ^ b; break;                 // C.XOR
+                case 0b10: result = a | b; break;                 // C.OR
+                default: result = a & b; break;                   // C.AND
+                }
+            }
+            break;
+        }
+        case 0b01'101:                                            // C.J
+            next_pc = pc + jump;
+            break;
+        case 0b01'110:                                            // C.BEQZ
+        case 0b01'111: {                                          // C.BNEZ
+            const int32_t offset = sign_extend(field(c, 12, 12) << 8 | field(c, 6, 5) << 6 | field(c, 2, 2) << 5 |
+                                                   field(c, 11, 10) << 3 | field(c, 4, 3) << 1,
+                                               9);
+            if ((regs[rp] == 0) == (funct3 == 0b110)) next_pc = pc + offset;
+            break;
+        }
+        case 0b10'000:                                            // C.SLLI
+            if (field(c, 12, 12)) illegal(c);
+            rd = r;
+            result = regs[r] << r2;
+            break;
+        case 0b10'010:                                            // C.LWSP
+            if (r == 0) illegal(c);
+            rd = r;
+            result = load(regs[2] + (field(c, 3, 2) << 6 | field(c, 12, 12) << 5 | field(c, 6, 4) << 2), 4, false);
+            break;
+        case 0b10'100:
+            if (r2 != 0) {                                        // C.MV, C.ADD
+                rd = r;
+                result = field(c, 12, 12) ? regs[r] + regs[r2] : regs[r2];
+                break;
+            }
+            if (r == 0) illegal(c);                               // C.EBREAK
+            next_pc = regs[r] & ~1u;                              // C.JR, C.JALR
+            if (field(c, 12, 12)) {
+                rd = 1;
+                result = pc + 2;
+            }
+            break;
+        case 0b10'110:                                            // C.SWSP
+            store(regs[2] + (field(c, 8, 7) << 6 | field(c, 12, 9) << 2), 4, regs[r2]);
+            break;
+        default:
+            illegal(c);
+        }
+
+        if (rd != 0) {
+            regs[rd] = result;
+            rec.rd = rd;
+            rec.value = result;
+        }
+        pc = next_pc;
+    }
+
+    [[noreturn]] static void illegal(uint32_t inst) {
+        throw std::runtime_error("FunctionalModel: illegal instruction " + std::to_string(inst));
+    }
+
+    uint32_t load(uint32_t addr, uint32_t size, bool is_signed) const {
+        if (static_cast<uint64_t>(addr) + size > memory.size()) {
+            throw std::runtime_error("FunctionalModel: load out of bounds at " + std::to_string(addr));
+        }
+        return is_signed ? static_cast<uint32_t>(bytes_to_sint(&memory[addr], &memory[addr] + size))
+                         : bytes_to_uint(&memory[addr], &memory[addr] + size);
+    }
+
+    void store(uint32_t addr, uint32_t size, uint32_t value) {
+        if (static_cast<uint64_t>(addr) + size > memory.size()) {
+            throw std::runtime_error("FunctionalModel: store out of bounds at " + std::to_string(addr));
+        }
+        auto bytes = uint_to_bytes(value);
+        std::copy_n(bytes.begin(), size, &memory[addr]);
+    }
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+// Lockstep co-simulation against a functional model.
+// The real implementation is enabled by defining the ENABLE_COSIM macro.
+// Otherwise, a dummy no-op implementation is used with zero overhead.
+
+#include "constants.hpp"
+#include "middlend/reg.hpp"
+#include "middlend/rob.hpp"
+
+#include <cstddef>
+#include <vector>
+
+#ifdef ENABLE_COSIM
+#include "cosim/iss.hpp"
+#include "utils/clock.hpp"
+#include "utils/dump.hpp"
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#endif
+
+#ifdef ENABLE_COSIM
+
+// --- REAL IMPLEMENTATION ---
+// Steps a FunctionalModel once per retirement and compares the architectural effect.
+// The first divergence prints a pipeline dump to std::cerr and stops the simulation.
+
+class LockstepChecker {
+    FunctionalModel model;
+    size_t retired = 0;
+
+public:
+    explicit LockstepChecker(const std::vector<std::byte>& initial_memory_image)
+        : model(initial_memory_image) {}
+
+    /**
+     * @brief Checks one retirement against the functional model.
+     * A fused entry steps the model twice and is compared with the later of the two
+     * instructions that writes a register.
+     * @param entry The ROB entry being committed.
+     * @param reg The register file before the commit is applied.
+     * @param rob The reorder buffer, dumped on divergence.
+     * @throws std::runtime_error at the first divergence.
+     */
+    void on_commit(const ROBEntry& entry, const RegisterFile& reg, const ReorderBuffer& rob) {
+        ++retired;
+        const PCType expected_pc = model.get_pc();
+        if (entry.pc - (entry.fused ? 4 : 0) != expected_pc) {
+            diverge("pc", entry, {expected_pc, model.fetch(expected_pc), 0, 0}, reg, rob);
+        }
+        RetireRecord expected = model.step();
+        if (entry.fused) {
+            if (entry.pc != model.get_pc()) {
+                diverge("fused pc", entry, {model.get_pc(), model.fetch(model.get_pc()), 0, 0}, reg, rob);
+            }
+            const RetireRecord second = model.step();
+            if (second.rd != 0) {
+                expected = second;
+            }
+        }
+        if (entry.reg_id != expected.rd) {
+            diverge("rd", entry, expected, reg, rob);
+        }
+        if (expected.rd != 0 && entry.value != expected.value) {
+            diverge("value", entry, expected, reg, rob);
+        }
+    }
+
+    /**
+     * @brief Checks that the model also reached the halt instruction.
+     */
+    void on_halt(const ROBEntry& entry, const RegisterFile& reg, const ReorderBuffer& rob) {
+        if (entry.pc != model.get_pc()) {
+            diverge("halt pc", entry, {model.get_pc(), model.fetch(model.get_pc()), 0, 0}, reg, rob);
+        }
+    }
+
+private:
+    [[noreturn]] void diverge(const char* field, const ROBEntry& got, const RetireRecord& expected,
+                              const RegisterFile& reg, const ReorderBuffer& rob) {
+        std::ostringstream oss;
+        oss << "=== co-simulation divergence on " << field << " ===\n"
+            << "retirement #" << retired << ", cycle " << Clock::getInstance().getTime() << "\n"
+            << "            pipeline      model\n"
+            << "  pc        " << norb::hex(got.pc) << "  " << norb::hex(expected.pc) << "\n"
+            << "  word      " << "            " << norb::hex(expected.word) << "\n"
+            << "  op        " << to_string(got.type) << "\n"
+            << "  rd        x" << static_cast<int>(got.reg_id) << "            x" << static_cast<int>(expected.rd) << "\n"
+            << "  value     " << norb::hex(got.value) << "  " << norb::hex(expected.value) << "\n";
+
+        oss << "--- architectural registers (pipeline before this retirement | model) ---\n";
+        const auto& core_regs = reg.get_snapshot();
+        const auto& model_regs = model.get_regs();
+        for (size_t i = 0; i < REG_SIZE; ++i) {
+            oss << "  x" << i << (i < 10 ? "  " : " ") << norb::hex(core_regs[i]) << " | " << norb::hex(model_regs[i])
+                << (core_regs[i] != model_regs[i] ? "  <-" : "") << "\n";
+        }
+        oss << "--- reorder buffer (head first) ---\n";
+        rob.dump(oss);
+
+        std::cerr << oss.str();
+        throw std::runtime_error(std::string("co-simulation diverged on ") + field);
+    }
+};
+
+#else
+
+// --- DUMMY (NO-OP) IMPLEMENTATION ---
+
+class LockstepChecker {
+public:
+    explicit LockstepChecker(const std::vector<std::byte>& /*initial_memory_image*/) {}
+    void on_commit(const ROBEntry&, const RegisterFile&, const ReorderBuffer&) {}
+    void on_halt(const ROBEntry&, const RegisterFile&, const ReorderBuffer&) {}
+};
+
+#endif // ENABLE_COSIM
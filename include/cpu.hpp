@@ -3,6 +3,8 @@
 #include "frontend/frontend.hpp"
 #include "middlend/control.hpp"
 #include "backend/backend.hpp"
+#include "cosim/lockstep.hpp"
+#include "utils/branch_trace.hpp"
 
 #include "utils/bus.hpp"
 #include "instruction.hpp"
@@ -13,12 +15,15 @@
 #include <array>
 #include <cstddef>
 #include <algorithm>
+#include <memory>
+#include <string>
 
 class CPU {
 private:
     std::array<std::byte, MEMORY_SIZE> unified_memory{};
+    LockstepChecker checker;
 
-    Channel<Instruction> decoded_instruction_c;
+    Channel<InstructionBundle> decoded_instruction_c;
     Channel<FilledInstruction> control_to_alu_rs_c;
     Channel<FilledInstruction> control_to_mem_rs_c;
     Channel<FilledInstruction> control_to_branch_rs_c;
@@ -27,14 +32,22 @@ private:
     CommonDataBus cdb;
     Bus<bool> global_flush_bus;
     Bus<ROBEntry> commit_bus;
+    HandshakeChannel<PCType> icache_refill_c;
+    Channel<PCType> icache_fill_c;
 
     // Core Pipeline Stages
     Frontend frontend;
     Controller control;
     Backend backend;
 
+    std::unique_ptr<BranchTraceWriter> branch_trace;
+
 public:
-    CPU(const std::vector<std::byte>& initial_memory_image) :
+    CPU(const std::vector<std::byte>& initial_memory_image,
+        PredictorKind predictor_kind = PredictorKind::TAGE_SC_L,
+        const std::string& branch_trace_path = "",
+        bool fusion = false) :
+        checker(initial_memory_image),
         decoded_instruction_c(),
         control_to_alu_rs_c(),
         control_to_mem_rs_c(),
@@ -50,7 +63,11 @@ public:
             decoded_instruction_c,
             mispredict_flush_pc_c,
             global_flush_bus,
-            commit_bus
+            commit_bus,
+            icache_refill_c,
+            icache_fill_c,
+            predictor_kind,
+            fusion
         ),
         control(
             decoded_instruction_c,
@@ -61,7 +78,8 @@ public:
             control_to_branch_rs_c,
             commit_bus,
             global_flush_bus,
-            mispredict_flush_pc_c
+            mispredict_flush_pc_c,
+            checker
         ),
         backend(
             unified_memory,
@@ -71,12 +89,31 @@ public:
             control_to_mem_rs_c,
             control_to_branch_rs_c,
             branch_unit_to_control_c,
-            commit_bus
+            commit_bus,
+            icache_refill_c,
+            icache_fill_c
         )
     {
         std::copy_n(initial_memory_image.begin(),
                     std::min(initial_memory_image.size(), unified_memory.size()),
                     unified_memory.begin());
+        if (!branch_trace_path.empty()) {
+            branch_trace = std::make_unique<BranchTraceWriter>(commit_bus, branch_trace_path);
+        }
                     
     }
+
+    /**
+     * @brief Ticks the global clock until the halt instruction reaches the head of the ROB.
+     * @return The value of a0 at the time of the halt.
+     */
+    RegDataType run() {
+        Clock& clock = Clock::getInstance();
+        while (!control.halted()) {
+            clock.tick();
+        }
+        return control.exit_value();
+    }
+
+    uint64_t committed_count() const { return control.committed_count(); }
 };
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "constants.hpp"
+#include "instruction.hpp"
+#include "utils/stats.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+
+/**
+ * @class BranchTargetBuffer
+ * @brief Set-associative cache of taken control-flow targets, indexed by fetch PC.
+ *
+ * PCLogic looks up every halfword of a fetch block and, on a hit, ends the block after
+ * that branch and continues from the stored target, so a predicted-taken branch costs no
+ * bubble. Entries remember whether the branch is a 16-bit (RV32C) instruction, which
+ * tells PCLogic where it ends. Entries are allocated when a taken branch or jump commits.
+ * Conditional branches keep a 2-bit counter so a branch that stops being taken falls
+ * through again; jumps are always followed. Ways are replaced least-recently-used.
+ *
+ * Counters: `btb.lookups`, `btb.hits` (hits that redirected fetch).
+ */
+template <size_t SETS, size_t WAYS>
+class BranchTargetBuffer {
+  static_assert(std::has_single_bit(SETS), "BTB set count must be a power of two");
+
+  static constexpr uint32_t INDEX_BITS = std::countr_zero(SETS);
+
+  struct Entry {
+    bool valid = false;
+    bool conditional = false;
+    bool compressed = false;
+    uint8_t counter = 0; // 2-bit; taken when >= 2
+    uint32_t tag = 0;
+    PCType target = 0;
+    uint64_t last_use = 0;
+  };
+
+  std::array<std::array<Entry, WAYS>, SETS> sets{};
+  uint64_t use_clock = 0;
+
+  uint64_t& lookups;
+  uint64_t& hits;
+
+  // Bit 1 of the PC goes into the tag, so RV32I code still uses every set.
+  static size_t index_of(PCType pc) { return (pc >> 2) & (SETS - 1); }
+  static uint32_t tag_of(PCType pc) { return (pc >> (2 + INDEX_BITS)) << 1 | ((pc >> 1) & 1); }
+
+  Entry* find(PCType pc) {
+    for (Entry& e : sets[index_of(pc)]) {
+      if (e.valid && e.tag == tag_of(pc)) {
+        return &e;
+      }
+    }
+    return nullptr;
+  }
+
+  Entry& victim(PCType pc) {
+    auto& set = sets[index_of(pc)];
+    Entry* oldest = &set[0];
+    for (Entry& e : set) {
+      if (!e.valid) {
+        return e;
+      }
+      if (e.last_use < oldest->last_use) {
+        oldest = &e;
+      }
+    }
+    return *oldest;
+  }
+
+public:
+  struct Prediction {
+    PCType target;
+    bool compressed; // the branch is 2 bytes long
+  };
+
+  BranchTargetBuffer()
+      : lookups(Stats::getInstance().counter("btb.lookups")),
+        hits(Stats::getInstance().counter("btb.hits")) {}
+
+  // Where to fetch after the branch at `pc`, or nullopt to fall through.
+  std::optional<Prediction> predict(PCType pc) {
+    ++lookups;
+    Entry* e = find(pc);
+    if (!e || (e->conditional && e->counter < 2)) {
+      return std::nullopt;
+    }
+    e->last_use = ++use_clock;
+    ++hits;
+    return Prediction{e->target, e->compressed};
+  }
+
+  // Trains on a committed branch or jump.
+  void update(PCType pc, OpType op, bool compressed, bool taken, PCType target) {
+    const bool conditional = is_conditional_branch(op);
+    Entry* e = find(pc);
+    if (!e) {
+      if (!taken) {
+        return;
+      }
+      e = &victim(pc);
+      *e = Entry{.valid = true, .conditional = conditional, .compressed = compressed, .counter = 2,
+                 .tag = tag_of(pc)};
+    } else if (taken && e->counter < 3) {
+      ++e->counter;
+    } else if (!taken && e->counter > 0) {
+      --e->counter;
+    }
+    if (taken) {
+      e->target = target;
+    }
+    e->last_use = ++use_clock;
+  }
+};
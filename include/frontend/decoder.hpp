@@ -1,35 +1,141 @@
 #pragma once
 #include "constants.hpp"
 #include "frontend/fetcher.hpp"
+#include "frontend/fusion.hpp"
+#include "frontend/indirect.hpp"
 #include "frontend/predictor.hpp"
+#include "frontend/ras.hpp"
+#include "frontend/rvc.hpp"
 #include "instruction.hpp"
 #include "middlend/rob.hpp"
 #include "utils/bus.hpp"
 #include "utils/clock.hpp"
+#include "utils/stats.hpp"
 #include "logger.hpp"
 
+#include <array>
+#include <memory>
+#include <optional>
+
+// Operand layout of an encoding: which register fields are used and how the
+// immediate is assembled.
+enum class InstFormat : uint8_t { R, I, I_SHIFT, S, B, U, J, NONE };
+
+struct DecodeEntry {
+  OpType op = OpType::INVALID;
+  InstFormat format = InstFormat::NONE;
+};
+
+// The table is indexed by opcode[6:2], funct3 and whether funct7 is 0b0100000
+// (the SUB/SRA/SRAI variant). The low opcode bits are always 0b11 in RV32I.
+constexpr size_t DECODE_TABLE_SIZE = 32 * 8 * 2;
+
+constexpr size_t decode_index(uint32_t opcode, uint32_t funct3, bool alt) {
+  return (((opcode >> 2) & 0x1F) << 4) | (funct3 << 1) | (alt ? 1 : 0);
+}
+
+consteval std::array<DecodeEntry, DECODE_TABLE_SIZE> make_decode_table() {
+  std::array<DecodeEntry, DECODE_TABLE_SIZE> table{};
+  // Sets the entry for both funct7 variants.
+  auto set = [&](uint32_t opcode, uint32_t funct3, OpType op, InstFormat format) {
+    table[decode_index(opcode, funct3, false)] = {op, format};
+    table[decode_index(opcode, funct3, true)] = {op, format};
+  };
+  // Sets the entry for every funct3, for encodings without one.
+  auto set_any = [&](uint32_t opcode, OpType op, InstFormat format) {
+    for (uint32_t funct3 = 0; funct3 < 8; ++funct3) set(opcode, funct3, op, format);
+  };
+
+  set_any(0b0110111, OpType::LUI, InstFormat::U);
+  set_any(0b0010111, OpType::AUIPC, InstFormat::U);
+  set_any(0b1101111, OpType::JAL, InstFormat::J);
+  set_any(0b1100111, OpType::JALR, InstFormat::I);
+
+  set(0b1100011, 0b000, OpType::BEQ, InstFormat::B);
+  set(0b1100011, 0b001, OpType::BNE, InstFormat::B);
+  set(0b1100011, 0b100, OpType::BLT, InstFormat::B);
+  set(0b1100011, 0b101, OpType::BGE, InstFormat::B);
+  set(0b1100011, 0b110, OpType::BLTU, InstFormat::B);
+  set(0b1100011, 0b111, OpType::BGEU, InstFormat::B);
+
+  set(0b0000011, 0b000, OpType::LB, InstFormat::I);
+  set(0b0000011, 0b001, OpType::LH, InstFormat::I);
+  set(0b0000011, 0b010, OpType::LW, InstFormat::I);
+  set(0b0000011, 0b100, OpType::LBU, InstFormat::I);
+  set(0b0000011, 0b101, OpType::LHU, InstFormat::I);
+
+  set(0b0100011, 0b000, OpType::SB, InstFormat::S);
+  set(0b0100011, 0b001, OpType::SH, InstFormat::S);
+  set(0b0100011, 0b010, OpType::SW, InstFormat::S);
+
+  set(0b0010011, 0b000, OpType::ADDI, InstFormat::I);
+  set(0b0010011, 0b010, OpType::SLTI, InstFormat::I);
+  set(0b0010011, 0b011, OpType::SLTIU, InstFormat::I);
+  set(0b0010011, 0b100, OpType::XORI, InstFormat::I);
+  set(0b0010011, 0b110, OpType::ORI, InstFormat::I);
+  set(0b0010011, 0b111, OpType::ANDI, InstFormat::I);
+  set(0b0010011, 0b001, OpType::SLLI, InstFormat::I_SHIFT);
+  set(0b0010011, 0b101, OpType::SRLI, InstFormat::I_SHIFT);
+  table[decode_index(0b0010011, 0b101, true)] = {OpType::SRAI, InstFormat::I_SHIFT};
+
+  set(0b0110011, 0b000, OpType::ADD, InstFormat::R);
+  table[decode_index(0b0110011, 0b000, true)] = {OpType::SUB, InstFormat::R};
+  set(0b0110011, 0b001, OpType::SLL, InstFormat::R);
+  set(0b0110011, 0b010, OpType::SLT, InstFormat::R);
+  set(0b0110011, 0b011, OpType::SLTU, InstFormat::R);
+  set(0b0110011, 0b100, OpType::XOR, InstFormat::R);
+  set(0b0110011, 0b101, OpType::SRL, InstFormat::R);
+  table[decode_index(0b0110011, 0b101, true)] = {OpType::SRA, InstFormat::R};
+  set(0b0110011, 0b110, OpType::OR, InstFormat::R);
+  set(0b0110011, 0b111, OpType::AND, InstFormat::R);
+  return table;
+}
+
+inline constexpr std::array<DecodeEntry, DECODE_TABLE_SIZE> DECODE_TABLE = make_decode_table();
+
 class Decoder {
-  Channel<FetchResult> &input_c;
+  InstructionBuffer &input_c;
   Bus<ROBEntry> &commit_bus;
 
-  Channel<Instruction> &output_c;
+  Channel<InstructionBundle> &output_c;
   Channel<PCType> &pc_pred_c;
 
   Bus<bool> &flush_bus;         
   Bus<bool> &frontend_flush_bus;
 
-  Predictor predictor;
+  std::unique_ptr<DirectionPredictor> predictor;
+  uint64_t history = 0;         // conditional branch directions, newest in bit 0
+  uint64_t retired_history = 0; // the same at commit, restores `history` on flush
+  ReturnAddressStack<RAS_SIZE> ras;         // speculative, updated at decode
+  ReturnAddressStack<RAS_SIZE> retired_ras; // updated at commit, restores `ras` on flush
+  IndirectPredictor<INDIRECT_TABLE_SIZE> indirect;
+  bool fusion;
+  std::optional<Instruction> held; // a fusion head that ended its fetch block
+
+  uint64_t& redirects = Stats::getInstance().counter("decoder.redirects");
+  uint64_t& ras_returns = Stats::getInstance().counter("ras.returns");
+  uint64_t& ras_mispredicts = Stats::getInstance().counter("ras.mispredicts");
+  uint64_t& conditional_branches = Stats::getInstance().counter("bp.conditional");
+  uint64_t& direction_mispredicts = Stats::getInstance().counter("bp.mispredicts");
+  uint64_t& fused_pairs = Stats::getInstance().counter("fusion.pairs");
+  std::array<uint64_t*, static_cast<size_t>(FusionKind::COUNT)> fused_by_kind;
 
 public:
-  Decoder(Channel<Instruction> &output_channel,
-          Channel<FetchResult> &input_channel,
+  Decoder(Channel<InstructionBundle> &output_channel,
+          InstructionBuffer &input_channel,
           Channel<PCType> &pc_pred_channel,
           Bus<bool> &flush_signal_from_execute,
           Bus<bool> &flush_signal_to_frontend,
-          Bus<ROBEntry> &commit_bus)
+          Bus<ROBEntry> &commit_bus,
+          PredictorKind predictor_kind,
+          bool fusion)
       : input_c(input_channel), commit_bus(commit_bus),
         output_c(output_channel), pc_pred_c(pc_pred_channel),
-        flush_bus(flush_signal_from_execute), frontend_flush_bus(flush_signal_to_frontend) {
+        flush_bus(flush_signal_from_execute), frontend_flush_bus(flush_signal_to_frontend),
+        predictor(make_direction_predictor(predictor_kind)), fusion(fusion) {
+    for (size_t k = 0; k < fused_by_kind.size(); ++k) {
+      fused_by_kind[k] = &Stats::getInstance().counter(FUSION_COUNTER_NAMES[k]);
+    }
     Clock::getInstance().subscribe([this] { this->work(); });
   }
 
@@ -37,7 +143,17 @@ public:
     auto rob_entry = commit_bus.get();
     if(rob_entry && rob_entry->is_branch){
       logger.With("pc", rob_entry->pc).With("taken", rob_entry->is_taken).Info("Updating predictor");
-      update_predictor(rob_entry->pc, rob_entry->is_taken);
+      retire_direction(*rob_entry);
+      retire_ras(*rob_entry);
+      indirect.retire(*rob_entry);
+    }
+    if (flush_bus.get()) {
+      // Everything younger than the committed state is squashed, so the retired
+      // copies are exactly what the speculative state should hold.
+      history = retired_history;
+      predictor->repair();
+      ras = retired_ras;
+      indirect.repair();
     }
     if (flush_bus.get() || frontend_flush_bus.get()) {
       logger.Info("Flushing decoder");
@@ -48,28 +164,78 @@ public:
       logger.Info("Decoder stalled");
       return;
     }
-    if (auto fetch_result = input_c.receive()) {
-      Instruction decoded_inst =
-          decode(fetch_result->instruction, fetch_result->pc);
-      logger.With("ins", to_string(decoded_inst)).Info("Decoded instruction");
-      handle_control_flow(decoded_inst);
-      output_c.send(decoded_inst);
+    if (auto block = input_c.receive()) {
+      InstructionBundle bundle;
+      if (held) {
+        bundle.push_back(*held);
+        held.reset();
+      }
+      bool redirected = false;
+      for (const FetchResult &fetch_result : *block) {
+        Instruction decoded_inst = decode(fetch_result.instruction, fetch_result.pc);
+        logger.With("ins", to_string(decoded_inst)).Info("Decoded instruction");
+        std::optional<FusedPair> pair;
+        if (fusion && !bundle.empty()) {
+          pair = fuse(bundle[bundle.size() - 1], decoded_inst);
+        }
+        if (pair) {
+          logger.With("ins", to_string(pair->ins)).Info("Fused with the previous instruction");
+          bundle[bundle.size() - 1] = pair->ins;
+          ++fused_pairs;
+          ++*fused_by_kind[static_cast<size_t>(pair->kind)];
+        } else {
+          bundle.push_back(decoded_inst);
+        }
+        // A redirect makes the rest of the block wrong-path.
+        if (handle_control_flow(bundle[bundle.size() - 1], fetch_result.predicted_next_pc)) {
+          redirected = true;
+          break;
+        }
+      }
+      // A head at the end of a block waits a block for its partner; fetch continues at
+      // the next PC since the block ended without a redirect.
+      if (fusion && !redirected && is_fusion_head(bundle[bundle.size() - 1])) {
+        held = bundle[bundle.size() - 1];
+        bundle.pop_back();
+      }
+      if (!bundle.empty()) {
+        output_c.send(bundle);
+      }
     }
   }
 
-  void update_predictor(PCType pc, bool actually_taken) {
-    predictor.update(pc, actually_taken);
-  }
-
 private:
   // This private method performs the flush action on this stage.
   void flush() {
     input_c.clear();
+    held.reset();
   }
 
-  void handle_control_flow(Instruction &inst) {
-    bool redirect_pc = false;
-    PCType target_pc = 0;
+  void retire_direction(const ROBEntry &e) {
+    if (!is_conditional_branch(e.type)) {
+      return;
+    }
+    predictor->update(e.pc, retired_history, e.is_taken);
+    retired_history = (retired_history << 1) | e.is_taken;
+    ++conditional_branches;
+    direction_mispredicts += e.predicted_taken != e.is_taken;
+  }
+
+  void retire_ras(const ROBEntry &e) {
+    if (e.is_return) {
+      retired_ras.pop();
+      ++ras_returns;
+      ras_mispredicts += e.mispredicted;
+    }
+    if (is_call(e.type, e.reg_id)) {
+      retired_ras.push(fallthrough_pc(e.pc, e.compressed));
+    }
+  }
+
+  // Picks where fetch continues after `inst` and redirects the frontend when PCLogic
+  // went somewhere else. Returns whether it redirected.
+  bool handle_control_flow(Instruction &inst, PCType fetched_next_pc) {
+    PCType next_pc = fallthrough_pc(inst.pc, inst.compressed);
 
     switch (inst.op) {
     case OpType::BEQ:
@@ -79,11 +245,11 @@ private:
     case OpType::BLTU:
     case OpType::BGEU:
       inst.is_branch = true;
-      inst.predicted_taken = predictor.predict(inst.pc);
+      inst.predicted_taken = predictor->predict(inst.pc, history);
+      history = (history << 1) | inst.predicted_taken;
       if (inst.predicted_taken) {
         logger.With("pc", inst.pc).With("target", inst.pc + inst.imm).Info("Branch predicted taken");
-        redirect_pc = true;
-        target_pc = inst.pc + inst.imm;
+        next_pc = inst.pc + inst.imm;
       }
       break;
 
@@ -91,190 +257,123 @@ private:
       logger.With("pc", inst.pc).With("target", inst.pc + inst.imm).Info("JAL detected");
       inst.is_branch = true;
       inst.predicted_taken = true;
-      redirect_pc = true;
-      target_pc = inst.pc + inst.imm;
+      next_pc = inst.pc + inst.imm;
       break;
 
     case OpType::JALR:
+      // The target is only known at execute. Returns take the top of the return
+      // address stack, other jumps the indirect predictor, and the BTB's target is
+      // the fallback for both.
       inst.is_branch = true;
-      inst.predicted_taken = false;
+      inst.predicted_taken = true;
+      next_pc = fetched_next_pc;
+      if (is_return(inst.op, inst.rd, inst.rs1)) {
+        if (auto target = ras.pop()) {
+          logger.With("pc", inst.pc).With("target", *target).Info("Return predicted from RAS");
+          next_pc = *target;
+        }
+      } else if (auto target = indirect.predict(inst.pc)) {
+        logger.With("pc", inst.pc).With("target", *target).Info("Indirect jump predicted");
+        next_pc = *target;
+      }
       break;
 
     default:
       break;
     }
+    if (is_call(inst.op, inst.rd)) {
+      ras.push(fallthrough_pc(inst.pc, inst.compressed));
+    }
+    if (inst.predicted_taken) {
+      indirect.speculate(inst.pc, next_pc);
+    }
+    inst.predicted_next_pc = next_pc;
 
-    if (redirect_pc) {
-      pc_pred_c.send(target_pc);
+    if (next_pc != fetched_next_pc) {
+      ++redirects;
+      pc_pred_c.send(next_pc);
       frontend_flush_bus.send(true);
-      logger.With("new pc",target_pc).Info("sending Prediction flush");
+      logger.With("new pc",next_pc).Info("sending Prediction flush");
+      return true;
     }
+    return false;
   }
 
  Instruction decode(uint32_t instruction_word, PCType current_pc) {
     Instruction decoded_inst;
     decoded_inst.pc = current_pc;
+    if (is_compressed(instruction_word)) {
+      decoded_inst.compressed = true;
+      instruction_word = expand_compressed(static_cast<uint16_t>(instruction_word));
+    }
 
     const uint32_t opcode = instruction_word & 0x7F;
-    const uint32_t rd = (instruction_word >> 7) & 0x1F;
     const uint32_t funct3 = (instruction_word >> 12) & 0x7;
-    const uint32_t rs1 = (instruction_word >> 15) & 0x1F;
-    const uint32_t rs2 = (instruction_word >> 20) & 0x1F;
     const uint32_t funct7 = (instruction_word >> 25) & 0x7F;
+    const DecodeEntry entry = (opcode & 0b11) == 0b11
+        ? DECODE_TABLE[decode_index(opcode, funct3, funct7 == 0b0100000)]
+        : DecodeEntry{};
 
-    switch (opcode) {
-    case 0b0110111: // LUI
-      decoded_inst.op = OpType::LUI;
-      decoded_inst.rd = rd;
-      decoded_inst.imm = instruction_word & 0xFFFFF000;
-      break;
-    case 0b0010111: // AUIPC
-      decoded_inst.op = OpType::AUIPC;
-      decoded_inst.rd = rd;
-      decoded_inst.imm = instruction_word & 0xFFFFF000;
-      break;
+    const RegIDType rd = (instruction_word >> 7) & 0x1F;
+    const RegIDType rs1 = (instruction_word >> 15) & 0x1F;
+    const RegIDType rs2 = (instruction_word >> 20) & 0x1F;
 
-    case 0b1101111: // JAL
-      decoded_inst.op = OpType::JAL;
+    decoded_inst.op = entry.op;
+    switch (entry.format) {
+    case InstFormat::R:
       decoded_inst.rd = rd;
-      {
-        uint32_t imm20 = (instruction_word >> 31) & 1;
-        uint32_t imm10_1 = (instruction_word >> 21) & 0x3FF;
-        uint32_t imm11 = (instruction_word >> 20) & 1;
-        uint32_t imm19_12 = (instruction_word >> 12) & 0xFF;
-        uint32_t imm_val =
-            (imm20 << 20) | (imm19_12 << 12) | (imm11 << 11) | (imm10_1 << 1);
-        decoded_inst.imm = static_cast<int32_t>(imm_val << 11) >> 11;
-      }
+      decoded_inst.rs1 = rs1;
+      decoded_inst.rs2 = rs2;
       break;
-
-    case 0b1100111: // JALR
-      decoded_inst.op = OpType::JALR;
+    case InstFormat::I:
       decoded_inst.rd = rd;
       decoded_inst.rs1 = rs1;
       decoded_inst.imm = static_cast<int32_t>(instruction_word) >> 20;
       break;
-
-    case 0b1100011: // BEQ, BNE, BLT, BGE, BLTU, BGEU
-      decoded_inst.rs1 = rs1;
-      decoded_inst.rs2 = rs2;
-      {
-        uint32_t imm12 = (instruction_word >> 31) & 1;
-        uint32_t imm10_5 = (instruction_word >> 25) & 0x3F;
-        uint32_t imm4_1 = (instruction_word >> 8) & 0xF;
-        uint32_t imm11 = (instruction_word >> 7) & 1;
-        uint32_t imm_val =
-            (imm12 << 12) | (imm11 << 11) | (imm10_5 << 5) | (imm4_1 << 1);
-        decoded_inst.imm = static_cast<int32_t>(imm_val << 19) >> 19;
-      }
-      switch (funct3) {
-      case 0b000: decoded_inst.op = OpType::BEQ; break;
-      case 0b001: decoded_inst.op = OpType::BNE; break;
-      case 0b100: decoded_inst.op = OpType::BLT; break;
-      case 0b101: decoded_inst.op = OpType::BGE; break;
-      case 0b110: decoded_inst.op = OpType::BLTU; break;
-      case 0b111: decoded_inst.op = OpType::BGEU; break;
-      default: decoded_inst.op = OpType::INVALID; break;
-      }
-      break;
-
-    case 0b0000011: // LB, LH, LW, LBU, LHU
+    case InstFormat::I_SHIFT:
       decoded_inst.rd = rd;
       decoded_inst.rs1 = rs1;
-      decoded_inst.imm = static_cast<int32_t>(instruction_word) >> 20;
-      switch (funct3) {
-      case 0b000: decoded_inst.op = OpType::LB; break;
-      case 0b001: decoded_inst.op = OpType::LH; break;
-      case 0b010: decoded_inst.op = OpType::LW; break;
-      case 0b100: decoded_inst.op = OpType::LBU; break;
-      case 0b101: decoded_inst.op = OpType::LHU; break;
-      default: decoded_inst.op = OpType::INVALID; break;
-      }
+      decoded_inst.imm = rs2; // shamt is in the rs2 field for I-type shifts
       break;
-
-    case 0b0100011: // SB, SH, SW
+    case InstFormat::S: {
       decoded_inst.rs1 = rs1;
       decoded_inst.rs2 = rs2;
-      {
-        uint32_t imm11_5 = (instruction_word >> 25) & 0x7F;
-        uint32_t imm4_0 = (instruction_word >> 7) & 0x1F;
-        uint32_t imm_val = (imm11_5 << 5) | imm4_0;
-        decoded_inst.imm = static_cast<int32_t>(imm_val << 20) >> 20;
-      }
-      switch (funct3) {
-      case 0b000: decoded_inst.op = OpType::SB; break;
-      case 0b001: decoded_inst.op = OpType::SH; break;
-      case 0b010: decoded_inst.op = OpType::SW; break;
-      default: decoded_inst.op = OpType::INVALID; break;
-      }
+      uint32_t imm11_5 = (instruction_word >> 25) & 0x7F;
+      uint32_t imm4_0 = (instruction_word >> 7) & 0x1F;
+      uint32_t imm_val = (imm11_5 << 5) | imm4_0;
+      decoded_inst.imm = static_cast<int32_t>(imm_val << 20) >> 20;
       break;
-
-    case 0b0010011: // ADDI, SLTI, SLTIU, XORI, ORI, ANDI, SLLI, SRLI, SRAI
-      decoded_inst.rd = rd;
+    }
+    case InstFormat::B: {
       decoded_inst.rs1 = rs1;
-      
-      // For shifts, the immediate is the 5-bit shamt. For others, it's a 12-bit sign-extended value.
-      if (funct3 == 0b001 || funct3 == 0b101) { // SLLI, SRLI, SRAI
-        decoded_inst.imm = rs2; // shamt is in the rs2 field for I-type shifts
-      } else { // ADDI, SLTI, SLTIU, XORI, ORI, ANDI
-        decoded_inst.imm = static_cast<int32_t>(instruction_word) >> 20;
-      }
-
-      switch (funct3) {
-      case 0b000: decoded_inst.op = OpType::ADDI; break;
-      case 0b010: decoded_inst.op = OpType::SLTI; break;
-      case 0b011: decoded_inst.op = OpType::SLTIU; break;
-      case 0b100: decoded_inst.op = OpType::XORI; break;
-      case 0b110: decoded_inst.op = OpType::ORI; break;
-      case 0b111: decoded_inst.op = OpType::ANDI; break;
-      case 0b001: decoded_inst.op = OpType::SLLI; break;
-      case 0b101: // SRLI / SRAI
-        if (funct7 == 0b0100000) {
-          decoded_inst.op = OpType::SRAI;
-        } else {
-          decoded_inst.op = OpType::SRLI;
-        }
-        break;
-      default: decoded_inst.op = OpType::INVALID; break;
-      }
+      decoded_inst.rs2 = rs2;
+      uint32_t imm12 = (instruction_word >> 31) & 1;
+      uint32_t imm10_5 = (instruction_word >> 25) & 0x3F;
+      uint32_t imm4_1 = (instruction_word >> 8) & 0xF;
+      uint32_t imm11 = (instruction_word >> 7) & 1;
+      uint32_t imm_val =
+          (imm12 << 12) | (imm11 << 11) | (imm10_5 << 5) | (imm4_1 << 1);
+      decoded_inst.imm = static_cast<int32_t>(imm_val << 19) >> 19;
       break;
-
-    case 0b0110011: // ADD, SUB, SLL, SLT, SLTU, XOR, SRL, SRA, OR, AND
+    }
+    case InstFormat::U:
       decoded_inst.rd = rd;
-      decoded_inst.rs1 = rs1;
-      decoded_inst.rs2 = rs2;
-      switch (funct3) {
-      case 0b000: // ADD / SUB
-        if (funct7 == 0b0100000) {
-          decoded_inst.op = OpType::SUB;
-        } else { // funct7 == 0b0000000
-          decoded_inst.op = OpType::ADD;
-        }
-        break;
-      case 0b001: decoded_inst.op = OpType::SLL; break;
-      case 0b010: decoded_inst.op = OpType::SLT; break;
-      case 0b011: decoded_inst.op = OpType::SLTU; break;
-      case 0b100: decoded_inst.op = OpType::XOR; break;
-      case 0b101: // SRL / SRA
-        if (funct7 == 0b0100000) {
-          decoded_inst.op = OpType::SRA;
-        } else { // funct7 == 0b0000000
-          decoded_inst.op = OpType::SRL;
-        }
-        break;
-      case 0b110: decoded_inst.op = OpType::OR; break;
-      case 0b111: decoded_inst.op = OpType::AND; break;
-      default: decoded_inst.op = OpType::INVALID; break;
-      }
+      decoded_inst.imm = instruction_word & 0xFFFFF000;
       break;
-
-    default:
-      decoded_inst.op = OpType::INVALID;
+    case InstFormat::J: {
+      decoded_inst.rd = rd;
+      uint32_t imm20 = (instruction_word >> 31) & 1;
+      uint32_t imm10_1 = (instruction_word >> 21) & 0x3FF;
+      uint32_t imm11 = (instruction_word >> 20) & 1;
+      uint32_t imm19_12 = (instruction_word >> 12) & 0xFF;
+      uint32_t imm_val =
+          (imm20 << 20) | (imm19_12 << 12) | (imm11 << 11) | (imm10_1 << 1);
+      decoded_inst.imm = static_cast<int32_t>(imm_val << 11) >> 11;
       break;
     }
-
-    if (decoded_inst.op == OpType::INVALID) {
+    case InstFormat::NONE:
       logger.With("word", instruction_word).Warn("Invalid instruction decoded");
+      break;
     }
     return decoded_inst;
   }
@@ -1,63 +1,187 @@
 #pragma once
 
 #include "constants.hpp"
+#include "frontend/icache.hpp"
+#include "frontend/pc.hpp"
+#include "frontend/rvc.hpp"
 #include "logger.hpp"
+#include "utils/bundle.hpp"
 #include "utils/bus.hpp"
 #include "utils/clock.hpp"
+#include "utils/queue.hpp"
+#include "utils/stats.hpp"
 #include <cstdint>
 #include <array>
 #include <cstddef>
+#include <optional>
 
 struct FetchResult{
     PCType pc;
     uint32_t instruction;
+    PCType predicted_next_pc;
 };
 
+using FetchBlock = Bundle<FetchResult, FETCH_BLOCK_MAX_INSTRUCTIONS>;
+using InstructionBuffer = QueueChannel<FetchBlock, IBUF_SIZE>;
+
+/**
+ * @class Fetcher
+ * @brief Takes fetch requests off the FTQ and reads their blocks through the I-cache.
+ *
+ * A hit reaches the instruction buffer ICACHE_HIT_LATENCY cycles later. A miss holds
+ * the request until Memory has refilled its line; later requests wait behind it. Every
+ * cycle the prefetcher walks the requests queued in the FTQ, which is the predicted
+ * path, and asks for their lines that are neither cached nor already requested.
+ * A flush drops the requests in flight, but refills already asked for still complete.
+ *
+ * Instructions are 2 or 4 bytes long and halfword aligned (RV32C). A 32-bit instruction
+ * whose second half lies in the next block is held back and completed by the next
+ * request if that one continues right after it; otherwise it was on a mispredicted path
+ * and the held half is dropped.
+ *
+ * Counters: `fetch.blocks`, `fetch.instructions`, `fetch.icache_stall_cycles`.
+ */
 class Fetcher {
-    Channel<PCType>& pc_chan;
+    struct InFlight {
+        FetchRequest request;
+        size_t wait; // cycles until the block can be handed to decode
+    };
+
+    FetchTargetQueue& pc_chan;
     Bus<bool> &flush_bus;
     Bus<bool>& frontend_flush_bus;
-    Channel<FetchResult>& instruction_chan;
+    InstructionBuffer& instruction_chan;
+    HandshakeChannel<PCType>& refill_c;
+    Channel<PCType>& fill_c;
     std::array<std::byte, MEMORY_SIZE>& unified_memory;
 
+    InstructionCache<ICACHE_SIZE, ICACHE_WAYS, CACHE_LINE_SIZE, ICACHE_MSHRS> icache;
+    queue<InFlight, ICACHE_HIT_LATENCY> pipeline;
+    std::optional<FetchRequest> missed; // waiting for its line
+
+    struct HeldHalf {
+        PCType pc;
+        uint16_t bits;
+    };
+    std::optional<HeldHalf> held; // first half of an instruction straddling two blocks
+
+    uint64_t& blocks = Stats::getInstance().counter("fetch.blocks");
+    uint64_t& fetched = Stats::getInstance().counter("fetch.instructions");
+    uint64_t& stall_cycles = Stats::getInstance().counter("fetch.icache_stall_cycles");
+
+    uint16_t read_half(PCType addr) const {
+        if (addr + 1 >= MEMORY_SIZE) {
+            logger.Warn("Instruction fetch out of bounds at PC: " + std::to_string(addr));
+            return 0x0000;
+        }
+        return static_cast<uint16_t>((std::to_integer<uint8_t>(unified_memory[addr + 1]) << 8) |
+                                     std::to_integer<uint8_t>(unified_memory[addr]));
+    }
+
+    void accept() {
+        if (missed) {
+            if (!icache.contains(missed->pc)) {
+                icache.request(missed->pc);
+                ++stall_cycles;
+                return;
+            }
+            pipeline.unchecked_push_back({*missed, ICACHE_HIT_LATENCY - 1});
+            missed.reset();
+            return;
+        }
+        if (pipeline.full()) {
+            return;
+        }
+        if (auto request = pc_chan.receive()) {
+            if (icache.access(request->pc)) {
+                pipeline.unchecked_push_back({*request, ICACHE_HIT_LATENCY - 1});
+            } else {
+                logger.With("pc", request->pc).Info("I-cache miss");
+                missed = *request;
+            }
+        }
+    }
+
+    void deliver() {
+        if (pipeline.empty() || pipeline.unchecked_front().wait > 0 || !instruction_chan.can_send()) {
+            return;
+        }
+        const FetchRequest& request = pipeline.unchecked_front().request;
+        const PCType end = request.pc + request.bytes;
+        FetchBlock block;
+        PCType addr = request.pc;
+        if (held && held->pc + 2 != addr) {
+            held.reset();
+        }
+        while (addr < end) {
+            PCType inst_pc = addr;
+            uint32_t inst = read_half(addr);
+            addr += 2;
+            if (held) {
+                inst_pc = held->pc;
+                inst = inst << 16 | held->bits;
+                held.reset();
+            } else if (!is_compressed(inst)) {
+                // Only a block that runs on sequentially can complete a straddling
+                // instruction. Any other block boundary inside an instruction came from
+                // a stale BTB hit, which decode corrects once it sees the whole instruction.
+                if (addr == end && request.predicted_next_pc == end) {
+                    held = HeldHalf{inst_pc, static_cast<uint16_t>(inst)};
+                    break;
+                }
+                inst |= static_cast<uint32_t>(read_half(addr)) << 16;
+                addr += 2;
+            }
+            logger.With("pc",inst_pc).With("Inst",inst).Info("Fetched Instruction");
+            block.push_back({inst_pc, inst, addr >= end ? request.predicted_next_pc : addr});
+        }
+        pipeline.unchecked_pop_front();
+        ++blocks;
+        fetched += block.size();
+        if (!block.empty()) {
+            instruction_chan.send(block);
+        }
+    }
+
 public:
     Fetcher(std::array<std::byte, MEMORY_SIZE>& memory,
-            Channel<PCType>& pc_channel,
+            FetchTargetQueue& pc_channel,
             Bus<bool>& flush_bus,
             Bus<bool>& frontend_flush_bus,
-            Channel<FetchResult>& instruction_channel)
-        : unified_memory(memory),
-          pc_chan(pc_channel),
+            InstructionBuffer& instruction_channel,
+            HandshakeChannel<PCType>& refill_channel,
+            Channel<PCType>& fill_channel)
+        : pc_chan(pc_channel),
           flush_bus(flush_bus),
           frontend_flush_bus(frontend_flush_bus),
-          instruction_chan(instruction_channel) {
+          instruction_chan(instruction_channel),
+          refill_c(refill_channel),
+          fill_c(fill_channel),
+          unified_memory(memory) {
             Clock::getInstance().subscribe([this]{this->work();});
     }
 
     void work(){
+        if (auto line = fill_c.receive()) {
+            icache.fill(*line);
+        }
         if (frontend_flush_bus.get() || flush_bus.get()) {
             pc_chan.reader_clear();
-            return;
-        }
-        if(!instruction_chan.can_send()){
-            return;
-        }
-        if(auto pc = pc_chan.receive()){
-            PCType addr = *pc;
-
-            if (addr + 3 >= MEMORY_SIZE) {
-                logger.Warn("Instruction fetch out of bounds at PC: " + std::to_string(addr));
-                instruction_chan.send({addr, 0x00000000});
-                return;
+            pipeline.clear();
+            missed.reset();
+            held.reset();
+        } else {
+            for (size_t i = 0; i < pipeline.size(); ++i) {
+                if (pipeline[i].wait > 0) {
+                    --pipeline[i].wait;
+                }
+            }
+            accept();
+            deliver();
+            for (size_t i = 0; i < pc_chan.size(); ++i) {
+                icache.prefetch(pc_chan[i].pc);
             }
-            uint32_t inst =
-                (static_cast<uint32_t>(std::to_integer<uint8_t>(unified_memory[addr + 3])) << 24) |
-                (static_cast<uint32_t>(std::to_integer<uint8_t>(unified_memory[addr + 2])) << 16) |
-                (static_cast<uint32_t>(std::to_integer<uint8_t>(unified_memory[addr + 1])) << 8)  |
-                (static_cast<uint32_t>(std::to_integer<uint8_t>(unified_memory[addr])));
-
-            logger.With("pc",*pc).With("Inst",inst).Info("Fetched Instruction");
-            instruction_chan.send({*pc, inst});
         }
+        icache.issue(refill_c);
     }
-};
\ No newline at end of file
+};
@@ -10,8 +10,8 @@
 
 class Frontend {
 private:
-    Channel<PCType> pc_to_fetch_c;
-    Channel<FetchResult> fetch_to_decode_c;
+    FetchTargetQueue pc_to_fetch_c{"ftq"};
+    InstructionBuffer fetch_to_decode_c{"ibuf"};
     Channel<PCType> decode_to_pc_pred_c;
     Bus<bool> frontend_flush_bus;
 
@@ -22,12 +22,16 @@ private:
 public:
     Frontend(
         std::array<std::byte, MEMORY_SIZE>& unified_memory,
-        Channel<Instruction>& decoded_instruction_c,
+        Channel<InstructionBundle>& decoded_instruction_c,
         Channel<PCType>& mispredict_flush_pc_c,
         Bus<bool>& global_flush_bus,
-        Bus<ROBEntry>& commit_bus
-    ) : pc_logic(decode_to_pc_pred_c, mispredict_flush_pc_c, pc_to_fetch_c),
-        fetcher(unified_memory, pc_to_fetch_c, global_flush_bus, frontend_flush_bus, fetch_to_decode_c), // Pass it to Fetcher
-        decoder(decoded_instruction_c, fetch_to_decode_c, decode_to_pc_pred_c, global_flush_bus, frontend_flush_bus, commit_bus)
+        Bus<ROBEntry>& commit_bus,
+        HandshakeChannel<PCType>& icache_refill_c,
+        Channel<PCType>& icache_fill_c,
+        PredictorKind predictor_kind,
+        bool fusion
+    ) : pc_logic(decode_to_pc_pred_c, mispredict_flush_pc_c, pc_to_fetch_c, commit_bus),
+        fetcher(unified_memory, pc_to_fetch_c, global_flush_bus, frontend_flush_bus, fetch_to_decode_c, icache_refill_c, icache_fill_c), // Pass it to Fetcher
+        decoder(decoded_instruction_c, fetch_to_decode_c, decode_to_pc_pred_c, global_flush_bus, frontend_flush_bus, commit_bus, predictor_kind, fusion)
     {}
 };
\ No newline at end of file
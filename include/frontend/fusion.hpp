@@ -0,0 +1,91 @@
+#pragma once
+
+#include "instruction.hpp"
+
+#include <array>
+#include <optional>
+
+// Instruction pairs the decoder can merge into one macro-op.
+enum class FusionKind : uint8_t {
+  LUI_ADDI,       // lui rd, hi; addi rd, rd, lo    -> lui rd, hi + lo
+  AUIPC_JALR,     // auipc rd, hi; jalr rd, lo(rd)  -> jal rd to the same target
+  AUIPC_LOAD,     // auipc rd, hi; l* rd, lo(rd)    -> l* rd, absolute(x0)
+  COMPARE_BRANCH, // slt[u] rd, a, b; bnez/beqz rd  -> blt[u]/bge[u] a, b, also writing rd
+  COUNT
+};
+
+inline constexpr std::array<const char *, static_cast<size_t>(FusionKind::COUNT)> FUSION_COUNTER_NAMES = {
+    "fusion.lui_addi", "fusion.auipc_jalr", "fusion.auipc_load", "fusion.compare_branch"};
+
+// Whether `ins` can start a pair, so the decoder should wait for the next instruction.
+// Pairs start with a 4-byte instruction, since the macro-op places its head at pc - 4.
+constexpr bool is_fusion_head(const Instruction &ins) {
+  return !ins.fused && !ins.compressed && ins.rd != 0 &&
+         (ins.op == OpType::LUI || ins.op == OpType::AUIPC || ins.op == OpType::SLT ||
+          ins.op == OpType::SLTU);
+}
+
+struct FusedPair {
+  Instruction ins;
+  FusionKind kind;
+};
+
+/**
+ * Merges two adjacent decoded instructions into one, or returns nullopt.
+ *
+ * The macro-op keeps the second instruction's PC, so branch prediction, the link address
+ * and the fall-through PC work unchanged; `fused` marks that the first instruction sits
+ * at pc - 4. Only pairs whose intermediate register value is overwritten by the second
+ * instruction are merged, except COMPARE_BRANCH, whose branch writes the comparison
+ * result to rd itself (see BranchUnit). The first instruction's own result is not kept;
+ * commit recovers it for the register dump (Committer::fused_head_value).
+ */
+inline std::optional<FusedPair> fuse(const Instruction &head, const Instruction &tail) {
+  if (!is_fusion_head(head) || tail.pc != head.pc + 4 || tail.rs1 != head.rd) {
+    return std::nullopt;
+  }
+  Instruction fused = tail;
+  fused.fused = true;
+  switch (head.op) {
+  case OpType::LUI:
+    if (tail.op == OpType::ADDI && tail.rd == head.rd) {
+      fused.op = OpType::LUI;
+      fused.rs1 = 0;
+      fused.imm = head.imm + tail.imm;
+      return FusedPair{fused, FusionKind::LUI_ADDI};
+    }
+    break;
+  case OpType::AUIPC:
+    if (tail.op == OpType::JALR && tail.rd == head.rd) {
+      fused.op = OpType::JAL;
+      fused.rs1 = 0;
+      // JALR clears bit 0 of its target. head.pc is even, so clearing it in the sum does.
+      fused.imm = ((head.imm + tail.imm) & ~RegDataType{1}) - 4; // relative to the jump's own PC
+      return FusedPair{fused, FusionKind::AUIPC_JALR};
+    }
+    if (op_traits(tail.op).is_load && tail.rd == head.rd) {
+      fused.rs1 = 0;
+      fused.imm = head.pc + head.imm + tail.imm;
+      return FusedPair{fused, FusionKind::AUIPC_LOAD};
+    }
+    break;
+  case OpType::SLT:
+  case OpType::SLTU:
+    if ((tail.op == OpType::BNE || tail.op == OpType::BEQ) && tail.rs2 == 0) {
+      const bool is_signed = head.op == OpType::SLT;
+      if (tail.op == OpType::BNE) {
+        fused.op = is_signed ? OpType::BLT : OpType::BLTU;
+      } else {
+        fused.op = is_signed ? OpType::BGE : OpType::BGEU;
+      }
+      fused.rd = head.rd;
+      fused.rs1 = head.rs1;
+      fused.rs2 = head.rs2;
+      return FusedPair{fused, FusionKind::COMPARE_BRANCH};
+    }
+    break;
+  default:
+    break;
+  }
+  return std::nullopt;
+}
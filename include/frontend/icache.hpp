@@ -0,0 +1,187 @@
+#pragma once
+
+#include "constants.hpp"
+#include "utils/bus.hpp"
+#include "utils/stats.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+/**
+ * @class InstructionCache
+ * @brief Tags of a set-associative instruction cache and its outstanding line refills.
+ *
+ * Only presence is modelled: instruction bits are still read from the unified memory,
+ * which nothing but the program's own stores can change. A missing line gets a miss
+ * status holding register (MSHR) and is requested from Memory over the refill channel,
+ * demand misses ahead of prefetches. fill() installs the line when Memory answers.
+ * Prefetches may not take the last free MSHR, which stays reserved for a demand miss.
+ * Ways are replaced least-recently-used.
+ *
+ * Counters: `icache.accesses`, `icache.misses`, `icache.prefetches` (refills issued for
+ * lines fetch had not asked for yet), `icache.useful_prefetches` (prefetched lines later
+ * hit by a fetch).
+ */
+template <size_t SIZE, size_t WAYS, size_t LINE, size_t MSHRS>
+class InstructionCache {
+  static_assert(std::has_single_bit(LINE), "I-cache line size must be a power of two");
+  static constexpr size_t SETS = SIZE / (WAYS * LINE);
+  static_assert(SETS * WAYS * LINE == SIZE && std::has_single_bit(SETS),
+                "I-cache size must be a power-of-two number of sets of WAYS lines");
+  static_assert(MSHRS >= 2, "one MSHR is reserved for demand misses");
+
+  static constexpr uint32_t OFFSET_BITS = std::countr_zero(LINE);
+  static constexpr uint32_t INDEX_BITS = std::countr_zero(SETS);
+
+  struct Line {
+    bool valid = false;
+    bool prefetched = false; // filled by a prefetch and not yet hit
+    uint32_t tag = 0;
+    uint64_t last_use = 0;
+  };
+
+  struct Mshr {
+    bool valid = false;
+    bool sent = false;
+    bool prefetch = false;
+    PCType line = 0;
+  };
+
+  std::array<std::array<Line, WAYS>, SETS> sets{};
+  std::array<Mshr, MSHRS> mshrs{};
+  uint64_t use_clock = 0;
+
+  uint64_t& accesses;
+  uint64_t& misses;
+  uint64_t& prefetches;
+  uint64_t& useful_prefetches;
+
+  static size_t index_of(PCType line) { return (line >> OFFSET_BITS) & (SETS - 1); }
+  static uint32_t tag_of(PCType line) { return line >> (OFFSET_BITS + INDEX_BITS); }
+
+  Line* find(PCType line) {
+    for (Line& l : sets[index_of(line)]) {
+      if (l.valid && l.tag == tag_of(line)) {
+        return &l;
+      }
+    }
+    return nullptr;
+  }
+
+  Line& victim(PCType line) {
+    auto& set = sets[index_of(line)];
+    Line* oldest = &set[0];
+    for (Line& l : set) {
+      if (!l.valid) {
+        return l;
+      }
+      if (l.last_use < oldest->last_use) {
+        oldest = &l;
+      }
+    }
+    return *oldest;
+  }
+
+  Mshr* find_mshr(PCType line) {
+    for (Mshr& m : mshrs) {
+      if (m.valid && m.line == line) {
+        return &m;
+      }
+    }
+    return nullptr;
+  }
+
+  size_t free_mshrs() const {
+    size_t free = 0;
+    for (const Mshr& m : mshrs) {
+      free += !m.valid;
+    }
+    return free;
+  }
+
+  bool allocate(PCType line, bool prefetch) {
+    for (Mshr& m : mshrs) {
+      if (!m.valid) {
+        m = Mshr{.valid = true, .sent = false, .prefetch = prefetch, .line = line};
+        return true;
+      }
+    }
+    return false;
+  }
+
+public:
+  InstructionCache()
+      : accesses(Stats::getInstance().counter("icache.accesses")),
+        misses(Stats::getInstance().counter("icache.misses")),
+        prefetches(Stats::getInstance().counter("icache.prefetches")),
+        useful_prefetches(Stats::getInstance().counter("icache.useful_prefetches")) {}
+
+  static PCType line_of(PCType addr) { return addr & ~static_cast<PCType>(LINE - 1); }
+
+  bool contains(PCType addr) { return find(line_of(addr)) != nullptr; }
+
+  // A fetch of `addr`. On a miss, requests the line unless it is already on its way.
+  bool access(PCType addr) {
+    ++accesses;
+    const PCType line = line_of(addr);
+    if (Line* l = find(line)) {
+      if (l->prefetched) {
+        l->prefetched = false;
+        ++useful_prefetches;
+      }
+      l->last_use = ++use_clock;
+      return true;
+    }
+    ++misses;
+    request(addr);
+    return false;
+  }
+
+  // Makes sure a demand refill of `addr`'s line is pending; false when no MSHR is free.
+  bool request(PCType addr) {
+    const PCType line = line_of(addr);
+    if (Mshr* m = find_mshr(line)) {
+      m->prefetch = false;
+      return true;
+    }
+    return allocate(line, false);
+  }
+
+  void prefetch(PCType addr) {
+    const PCType line = line_of(addr);
+    if (find(line) || find_mshr(line) || free_mshrs() < 2) {
+      return;
+    }
+    allocate(line, true);
+    ++prefetches;
+  }
+
+  // Sends one unsent refill, demand misses first, when Memory can take it.
+  void issue(HandshakeChannel<PCType>& refill_c) {
+    if (!refill_c.can_send()) {
+      return;
+    }
+    Mshr* next = nullptr;
+    for (Mshr& m : mshrs) {
+      if (m.valid && !m.sent && (!next || (next->prefetch && !m.prefetch))) {
+        next = &m;
+      }
+    }
+    if (next) {
+      refill_c.send(next->line);
+      next->sent = true;
+    }
+  }
+
+  void fill(PCType line) {
+    Mshr* m = find_mshr(line);
+    const bool prefetch = m && m->prefetch;
+    if (m) {
+      m->valid = false;
+    }
+    if (!find(line)) {
+      victim(line) = Line{.valid = true, .prefetched = prefetch, .tag = tag_of(line), .last_use = ++use_clock};
+    }
+  }
+};
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "constants.hpp"
+#include "frontend/predictors/direction.hpp"
+#include "instruction.hpp"
+#include "middlend/rob.hpp"
+#include "utils/stats.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+
+/**
+ * @class IndirectPredictor
+ * @brief Target predictor for indirect jumps (JALR that are not returns), ITTAGE-style.
+ *
+ * A tagless base table indexed by PC backs TAGGED_TABLES tagged tables. Each tagged table
+ * is indexed by the PC hashed with a longer slice of the path history: the last taken
+ * branches, PATH_BITS bits of each. The longest-history table whose tag matches provides
+ * the target. A mispredicted jump allocates an entry in a longer table.
+ *
+ * Path history is updated speculatively at decode. A retired copy is updated from the
+ * commit bus and replaces the speculative one on a flush. The retired copy also matches
+ * the speculative history at the time a jump was predicted, so training recomputes the
+ * lookup with it instead of carrying the table indices down the pipeline.
+ *
+ * Counters: `indirect.jumps`, `indirect.mispredicts`, `indirect.tagged_hits`.
+ */
+template <size_t TABLE_SIZE>
+class IndirectPredictor {
+  static_assert(std::has_single_bit(TABLE_SIZE), "table size must be a power of two");
+
+  static constexpr size_t TAGGED_TABLES = 4;
+  static constexpr uint32_t PATH_BITS = 3;
+  // Taken branches of history used by each tagged table, shortest first.
+  static constexpr std::array<uint32_t, TAGGED_TABLES> HISTORY_LENGTHS = {2, 4, 8, 16};
+  static constexpr uint32_t INDEX_BITS = std::countr_zero(TABLE_SIZE);
+  static constexpr uint32_t TAG_BITS = 9;
+
+  struct BaseEntry {
+    bool valid = false;
+    PCType target = 0;
+  };
+
+  struct TaggedEntry {
+    uint16_t tag = 0; // 0 marks an empty entry
+    uint8_t confidence = 0; // 2-bit
+    bool useful = false;
+    PCType target = 0;
+  };
+
+  struct Lookup {
+    std::array<size_t, TAGGED_TABLES> index;
+    std::array<uint16_t, TAGGED_TABLES> tag;
+    int provider = -1; // tagged table that matched, -1 for the base table
+  };
+
+  std::array<BaseEntry, TABLE_SIZE> base{};
+  std::array<std::array<TaggedEntry, TABLE_SIZE>, TAGGED_TABLES> tagged{};
+  uint64_t history = 0;
+  uint64_t retired_history = 0;
+
+  uint64_t& jumps;
+  uint64_t& mispredicts;
+  uint64_t& tagged_hits;
+
+  Lookup lookup(PCType pc, uint64_t h) const {
+    Lookup l;
+    const uint32_t p = pc >> 2;
+    for (size_t t = 0; t < TAGGED_TABLES; ++t) {
+      const uint32_t length = HISTORY_LENGTHS[t] * PATH_BITS;
+      l.index[t] = (p ^ (p >> INDEX_BITS) ^ fold_history(h, length, INDEX_BITS) ^ t) & (TABLE_SIZE - 1);
+      uint16_t tag = static_cast<uint16_t>((p ^ (fold_history(h, length, TAG_BITS - 1) << 1)) & ((1u << TAG_BITS) - 1));
+      l.tag[t] = tag ? tag : 1;
+      if (tagged[t][l.index[t]].tag == l.tag[t]) {
+        l.provider = static_cast<int>(t);
+      }
+    }
+    return l;
+  }
+
+  // Shifts in PATH_BITS bits hashed from the branch and its target. The target is
+  // folded so that jump tables with a power-of-two stride still differ in the low bits.
+  static uint64_t push_path(uint64_t h, PCType pc, PCType target) {
+    const uint32_t t = target >> 2;
+    const uint32_t bits = (pc >> 2) ^ t ^ (t >> PATH_BITS) ^ (t >> (2 * PATH_BITS));
+    return (h << PATH_BITS) ^ (bits & ((1u << PATH_BITS) - 1));
+  }
+
+public:
+  IndirectPredictor()
+      : jumps(Stats::getInstance().counter("indirect.jumps")),
+        mispredicts(Stats::getInstance().counter("indirect.mispredicts")),
+        tagged_hits(Stats::getInstance().counter("indirect.tagged_hits")) {}
+
+  std::optional<PCType> predict(PCType pc) const {
+    Lookup l = lookup(pc, history);
+    if (l.provider >= 0) {
+      return tagged[l.provider][l.index[l.provider]].target;
+    }
+    const BaseEntry& b = base[(pc >> 2) & (TABLE_SIZE - 1)];
+    return b.valid ? std::optional<PCType>(b.target) : std::nullopt;
+  }
+
+  // Records a branch or jump the frontend predicted taken.
+  void speculate(PCType pc, PCType target) { history = push_path(history, pc, target); }
+
+  // Trains on a committed branch or jump and advances the retired history.
+  void retire(const ROBEntry& e) {
+    if (e.type == OpType::JALR && !e.is_return) {
+      train(e.pc, e.target_pc, e.mispredicted);
+    }
+    if (e.is_taken) {
+      retired_history = push_path(retired_history, e.pc, e.target_pc);
+    }
+  }
+
+  void repair() { history = retired_history; }
+
+private:
+  void train(PCType pc, PCType target, bool mispredicted) {
+    ++jumps;
+    mispredicts += mispredicted;
+
+    Lookup l = lookup(pc, retired_history);
+    BaseEntry& b = base[(pc >> 2) & (TABLE_SIZE - 1)];
+    bool provider_correct;
+    if (l.provider >= 0) {
+      ++tagged_hits;
+      TaggedEntry& e = tagged[l.provider][l.index[l.provider]];
+      provider_correct = e.target == target;
+      if (provider_correct) {
+        if (e.confidence < 3) ++e.confidence;
+        e.useful = e.useful || (b.valid && b.target != target);
+      } else if (e.confidence > 0) {
+        --e.confidence;
+      } else {
+        e.target = target;
+      }
+    } else {
+      provider_correct = b.valid && b.target == target;
+    }
+    b.valid = true;
+    b.target = target;
+
+    if (provider_correct) {
+      return;
+    }
+    // Allocate in the first longer table with a free slot; age the candidates if none.
+    const size_t first = static_cast<size_t>(l.provider + 1);
+    for (size_t t = first; t < TAGGED_TABLES; ++t) {
+      TaggedEntry& e = tagged[t][l.index[t]];
+      if (!e.useful) {
+        e = TaggedEntry{.tag = l.tag[t], .confidence = 0, .useful = false, .target = target};
+        return;
+      }
+    }
+    for (size_t t = first; t < TAGGED_TABLES; ++t) {
+      tagged[t][l.index[t]].useful = false;
+    }
+  }
+};
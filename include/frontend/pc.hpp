@@ -1,42 +1,92 @@
 #pragma once
 
 #include "constants.hpp"
+#include "frontend/btb.hpp"
 #include "logger.hpp"
+#include "middlend/rob.hpp"
 #include "utils/bus.hpp"
 #include "utils/clock.hpp"
 
+// A fetch block: the `bytes` bytes starting at `pc`.
+struct FetchRequest {
+    PCType pc;
+    uint8_t bytes;
+    PCType predicted_next_pc; // where PCLogic continued after the block
+};
+
+// Decouples prediction from fetch: PCLogic keeps predicting while fetch is stalled.
+using FetchTargetQueue = QueueChannel<FetchRequest, FTQ_SIZE>;
+
 class PCLogic {
     PCType pc;
     // Input
     Channel<PCType>& prediction_c;
     Channel<PCType>& flush_c;
+    Bus<ROBEntry>& commit_bus;
     // Output
-    Channel<PCType>& final_pc;
+    FetchTargetQueue& final_pc;
+
+    BranchTargetBuffer<BTB_SETS, BTB_WAYS> btb;
+    // Target of a predicted-taken 32-bit branch that straddles the end of the last block.
+    // The next request covers only its second half and continues from here.
+    std::optional<PCType> straddle_target;
 
 public:
-    PCLogic(Channel<PCType>& pred, Channel<PCType>& flush, Channel<PCType>& final)
-        : pc(0), prediction_c(pred), flush_c(flush), final_pc(final) {
+    PCLogic(Channel<PCType>& pred, Channel<PCType>& flush, FetchTargetQueue& final,
+            Bus<ROBEntry>& commit_bus)
+        : pc(0), prediction_c(pred), flush_c(flush), commit_bus(commit_bus), final_pc(final) {
         Clock::getInstance().subscribe([this]{ this->work(); });
     }
     void work() {
+        auto committed = commit_bus.get();
+        if (committed && committed->is_branch) {
+            btb.update(committed->pc, committed->type, committed->compressed, committed->is_taken,
+                       committed->target_pc);
+        }
         if(flush_c.peek()||prediction_c.peek()){
             final_pc.writer_clear();
         }
         if (auto flush_result = flush_c.receive()) {
-            logger.With("old",pc).With("new",flush_result.value()).Info("Overwrite with flush");
-            pc = flush_result.value();
+            logger.With("old",pc).With("new",*flush_result).Info("Overwrite with flush");
+            pc = *flush_result;
             prediction_c.clear();
+            straddle_target.reset();
         }
         else if (auto pred_result = prediction_c.receive()) {
-            logger.With("old",pc).With("new",pred_result.value()).Info("Overwrite with prediction");
-            pc = pred_result.value();
+            logger.With("old",pc).With("new",*pred_result).Info("Overwrite with prediction");
+            pc = *pred_result;
+            straddle_target.reset();
         }
         logger.With("pc", pc).Info("sending PC");
         if (!final_pc.can_send()) {
             return; // STALL
         }
-        final_pc.send(pc);
+        if (straddle_target) {
+            final_pc.send({pc, 2, *straddle_target});
+            pc = *straddle_target;
+            straddle_target.reset();
+            return;
+        }
+        // Look up every halfword of the rest of the aligned block; a predicted-taken
+        // branch ends it.
+        const PCType block_end = (pc & ~static_cast<PCType>(FETCH_BLOCK_BYTES - 1)) + FETCH_BLOCK_BYTES;
+        PCType end = block_end;
+        PCType next_pc = block_end;
+        for (PCType slot_pc = pc; slot_pc < block_end; slot_pc += 2) {
+            if (auto hit = btb.predict(slot_pc)) {
+                logger.With("pc", slot_pc).With("target", hit->target).Info("BTB hit");
+                const PCType branch_end = fallthrough_pc(slot_pc, hit->compressed);
+                if (branch_end > block_end) {
+                    straddle_target = hit->target;
+                } else {
+                    end = branch_end;
+                    next_pc = hit->target;
+                }
+                break;
+            }
+        }
+        final_pc.send({pc, static_cast<uint8_t>(end - pc), next_pc});
 
-        pc += 4;
+        pc = next_pc;
     }
-};
\ No newline at end of file
+};
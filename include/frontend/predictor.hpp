@@ -1,51 +1,32 @@
 #pragma once
-#include "constants.hpp"
-#include "logger.hpp"
-#include <map>
 
-
-enum STATUS {
-    STRONG_NOT = 0,
-    WEAK_NOT   = 1,
-    WEAK_YES   = 2,
-    STRONG_YES = 3 
-};
-
-
-class Predictor {
-private:
-    std::map<PCType, STATUS> prediction_table;
-
-public:
-    bool predict(PCType pc) {
-        auto it = prediction_table.find(pc);
-
-        if (it == prediction_table.end()) {
-            logger.With("pc",pc).Info(("New entry,Not Taken"));
-            return false; 
-        }
-        
-        STATUS current_status = it->second;
-        bool result = (current_status == WEAK_YES || current_status == STRONG_YES);
-        logger.With("pc",pc).Info((result?"Taken":"Not Taken"));
-        return result;
-    }
-
-    void update(PCType pc, bool actually_taken) {
-        if (prediction_table.find(pc) == prediction_table.end()) {
-            prediction_table[pc] = WEAK_NOT;
-        }
-        
-        STATUS& current_status = prediction_table[pc];
-
-        if (actually_taken) {
-            if (current_status != STRONG_YES) {
-                current_status = static_cast<STATUS>(current_status + 1);
-            }
-        } else {
-            if (current_status != STRONG_NOT) {
-                current_status = static_cast<STATUS>(current_status - 1);
-            }
-        }
-    }
-};
\ No newline at end of file
+#include "frontend/predictors/bimodal.hpp"
+#include "frontend/predictors/direction.hpp"
+#include "frontend/predictors/gshare.hpp"
+#include "frontend/predictors/perceptron.hpp"
+#include "frontend/predictors/tage.hpp"
+
+#include <memory>
+#include <optional>
+#include <string_view>
+
+// Direction predictors selectable at run time, each sized to a few KiB of state.
+enum class PredictorKind { BIMODAL, GSHARE, TAGE_SC_L, PERCEPTRON };
+
+inline std::optional<PredictorKind> parse_predictor_kind(std::string_view name) {
+  if (name == "bimodal") return PredictorKind::BIMODAL;
+  if (name == "gshare") return PredictorKind::GSHARE;
+  if (name == "tage") return PredictorKind::TAGE_SC_L;
+  if (name == "perceptron") return PredictorKind::PERCEPTRON;
+  return std::nullopt;
+}
+
+inline std::unique_ptr<DirectionPredictor> make_direction_predictor(PredictorKind kind) {
+  switch (kind) {
+  case PredictorKind::BIMODAL: return std::make_unique<BimodalPredictor<16384>>();
+  case PredictorKind::GSHARE: return std::make_unique<GsharePredictor<16384>>();
+  case PredictorKind::PERCEPTRON: return std::make_unique<PerceptronPredictor<256, 31>>();
+  case PredictorKind::TAGE_SC_L: break;
+  }
+  return std::make_unique<TageScLPredictor>();
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "frontend/predictors/direction.hpp"
+
+#include <array>
+#include <bit>
+
+// A table of 2-bit counters indexed by PC; ignores history.
+template <size_t ENTRIES>
+class BimodalPredictor : public DirectionPredictor {
+  static_assert(std::has_single_bit(ENTRIES), "table size must be a power of two");
+
+  std::array<uint8_t, ENTRIES> counters;
+
+  static size_t index(PCType pc) { return (pc >> 2) & (ENTRIES - 1); }
+
+public:
+  BimodalPredictor() { counters.fill(1); } // weakly not taken
+
+  const char* name() const override { return "bimodal"; }
+
+  bool predict(PCType pc, uint64_t) override { return counters[index(pc)] >= 2; }
+
+  void update(PCType pc, uint64_t, bool taken) override {
+    saturate_step<uint8_t>(counters[index(pc)], taken, 0, 3);
+  }
+};
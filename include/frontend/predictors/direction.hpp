@@ -0,0 +1,64 @@
+#pragma once
+
+#include "constants.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * @class DirectionPredictor
+ * @brief Interface of the conditional-branch direction predictors.
+ *
+ * The Decoder owns the global history: bit 0 is the direction of the most recent
+ * conditional branch. It passes the speculative history to predict() at decode and
+ * the retired history to update() at commit; on the correct path the two are the same
+ * value, so implementations can recompute their table indices at update time.
+ */
+class DirectionPredictor {
+public:
+  virtual ~DirectionPredictor() = default;
+
+  virtual const char* name() const = 0;
+
+  virtual bool predict(PCType pc, uint64_t history) = 0;
+
+  // Trains with the committed outcome of a branch predicted under `history`.
+  virtual void update(PCType pc, uint64_t history, bool taken) = 0;
+
+  // Drops speculative state after a pipeline flush. Only stateful predictors need it.
+  virtual void repair() {}
+};
+
+// Saturating counter step within [lo, hi].
+template <typename T>
+constexpr void saturate_step(T& counter, bool up, T lo, T hi) {
+  if (up) {
+    counter = std::min<T>(static_cast<T>(counter + 1), hi);
+  } else {
+    counter = std::max<T>(static_cast<T>(counter - 1), lo);
+  }
+}
+
+// XORs the low `length` history bits down to `bits` bits.
+constexpr uint32_t fold_history(uint64_t history, uint32_t length, uint32_t bits) {
+  if (length < 64) {
+    history &= (uint64_t{1} << length) - 1;
+  }
+  uint32_t folded = 0;
+  for (; history; history >>= bits) {
+    folded ^= static_cast<uint32_t>(history) & ((1u << bits) - 1);
+  }
+  return folded;
+}
+
+// fold_history((previous << 1) | taken, LENGTH, BITS) from `folded`, the same fold of
+// `previous`: a circular shift register takes the new direction in and XORs out the one
+// leaving the LENGTH-bit window, instead of a pass over the whole history.
+template <uint32_t LENGTH, uint32_t BITS>
+constexpr uint32_t shift_folded(uint32_t folded, uint64_t previous, bool taken) {
+  const uint32_t outgoing = static_cast<uint32_t>(previous >> (LENGTH - 1)) & 1;
+  folded = (folded << 1) | taken;
+  folded ^= outgoing << (LENGTH % BITS);
+  folded ^= folded >> BITS;
+  return folded & ((1u << BITS) - 1);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "frontend/predictors/direction.hpp"
+
+#include <array>
+#include <bit>
+
+// 2-bit counters indexed by the PC XORed with the last log2(ENTRIES) branch directions.
+template <size_t ENTRIES>
+class GsharePredictor : public DirectionPredictor {
+  static_assert(std::has_single_bit(ENTRIES), "table size must be a power of two");
+
+  std::array<uint8_t, ENTRIES> counters;
+
+  static size_t index(PCType pc, uint64_t history) {
+    return ((pc >> 2) ^ history) & (ENTRIES - 1);
+  }
+
+public:
+  GsharePredictor() { counters.fill(1); }
+
+  const char* name() const override { return "gshare"; }
+
+  bool predict(PCType pc, uint64_t history) override {
+    return counters[index(pc, history)] >= 2;
+  }
+
+  void update(PCType pc, uint64_t history, bool taken) override {
+    saturate_step<uint8_t>(counters[index(pc, history)], taken, 0, 3);
+  }
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "frontend/predictors/direction.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdlib>
+
+/**
+ * @class PerceptronPredictor
+ * @brief Jiménez-Lin perceptron predictor.
+ *
+ * Each PC selects a vector of HISTORY + 1 signed weights. The prediction is the sign of
+ * the bias weight plus the dot product with the history taken as +1/-1. Training happens
+ * on a misprediction or when the output is within THETA of zero.
+ */
+template <size_t ENTRIES, size_t HISTORY>
+class PerceptronPredictor : public DirectionPredictor {
+  static_assert(std::has_single_bit(ENTRIES), "table size must be a power of two");
+  static_assert(HISTORY <= 64, "history is a 64-bit word");
+
+  static constexpr int THETA = static_cast<int>(1.93 * HISTORY + 14);
+
+  std::array<std::array<int8_t, HISTORY + 1>, ENTRIES> weights{};
+
+  static size_t index(PCType pc) { return (pc >> 2) & (ENTRIES - 1); }
+
+  int output(PCType pc, uint64_t history) const {
+    const auto& w = weights[index(pc)];
+    int y = w[0];
+    for (size_t i = 0; i < HISTORY; ++i) {
+      y += (history >> i & 1) ? w[i + 1] : -w[i + 1];
+    }
+    return y;
+  }
+
+public:
+  const char* name() const override { return "perceptron"; }
+
+  bool predict(PCType pc, uint64_t history) override { return output(pc, history) >= 0; }
+
+  void update(PCType pc, uint64_t history, bool taken) override {
+    const int y = output(pc, history);
+    if ((y >= 0) == taken && std::abs(y) > THETA) {
+      return;
+    }
+    auto& w = weights[index(pc)];
+    saturate_step<int8_t>(w[0], taken, -128, 127);
+    for (size_t i = 0; i < HISTORY; ++i) {
+      saturate_step<int8_t>(w[i + 1], taken == static_cast<bool>(history >> i & 1), -128, 127);
+    }
+  }
+};
@@ -0,0 +1,312 @@
+#pragma once
+
+#include "frontend/predictors/direction.hpp"
+#include "utils/stats.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdlib>
+#include <utility>
+
+/**
+ * @class TageScLPredictor
+ * @brief A reduced TAGE-SC-L: TAGE, a statistical corrector and a loop predictor.
+ *
+ * TAGE: a bimodal base table and TABLES tagged tables indexed by the PC hashed with
+ * geometrically longer slices of the global history (up to the full 64 bits). The
+ * longest matching table provides the prediction, except that a weak, not yet useful
+ * entry defers to the next shorter match while `use_alt_on_new` says that pays off.
+ * A misprediction allocates an entry in a longer table.
+ *
+ * SC: two small tables of signed counters, indexed by PC and by PC with recent history,
+ * each split by the TAGE direction. Their sum plus the TAGE confidence can overturn a
+ * TAGE prediction the history tables have seen fail.
+ *
+ * L: a few tagged entries that learn a loop branch's trip count and, once it has
+ * repeated LOOP_CONFIDENT times, predict the exit. Each entry keeps a speculative
+ * iteration count advanced at predict() and a retired one advanced at update(); repair()
+ * copies the latter over the former.
+ *
+ * The folded histories that index and tag the tables are kept incrementally, one set
+ * for the speculative history predict() sees and one for the retired history update()
+ * sees; repair() copies the retired set over the speculative one.
+ *
+ * Counters: `tage.sc_flips`, `tage.loop_predictions`.
+ */
+class TageScLPredictor : public DirectionPredictor {
+  static constexpr size_t BASE_ENTRIES = 4096;
+  static constexpr size_t TABLES = 5;
+  static constexpr uint32_t INDEX_BITS = 10;
+  static constexpr uint32_t TAG_BITS = 10;
+  static constexpr std::array<uint32_t, TABLES> HISTORY_LENGTHS = {4, 9, 18, 36, 64};
+  static constexpr uint64_t USEFUL_RESET_PERIOD = 1u << 18;
+
+  static constexpr uint32_t SC_BITS = 10;
+  static constexpr int SC_THRESHOLD = 6;
+  static constexpr uint32_t SC_HISTORY_LENGTH = 12;
+
+  static constexpr size_t LOOP_ENTRIES = 64;
+  static constexpr uint8_t LOOP_CONFIDENT = 3;
+
+  struct TaggedEntry {
+    int8_t counter = 0; // 3-bit signed, taken when >= 0
+    uint8_t useful = 0; // 2-bit
+    uint16_t tag = 0;   // 0 marks an empty entry
+  };
+
+  struct LoopEntry {
+    uint16_t tag = 0;
+    uint16_t trip = 0; // taken iterations before the exit
+    uint16_t spec_iter = 0;
+    uint16_t retired_iter = 0;
+    uint8_t confidence = 0;
+  };
+
+  // Every fold of one history stream the tables use, kept up to date a branch at a time.
+  struct Folds {
+    uint64_t history = 0;
+    std::array<uint32_t, TABLES> index{};     // HISTORY_LENGTHS[t] folded to INDEX_BITS
+    std::array<uint32_t, TABLES> tag{};       // ... to TAG_BITS
+    std::array<uint32_t, TABLES> tag_short{}; // ... to TAG_BITS - 1
+    uint32_t sc = 0;                          // SC_HISTORY_LENGTH folded to SC_BITS - 1
+
+    template <size_t... T>
+    void shift(std::index_sequence<T...>, bool taken) {
+      ((index[T] = shift_folded<HISTORY_LENGTHS[T], INDEX_BITS>(index[T], history, taken)), ...);
+      ((tag[T] = shift_folded<HISTORY_LENGTHS[T], TAG_BITS>(tag[T], history, taken)), ...);
+      ((tag_short[T] = shift_folded<HISTORY_LENGTHS[T], TAG_BITS - 1>(tag_short[T], history, taken)), ...);
+      sc = shift_folded<SC_HISTORY_LENGTH, SC_BITS - 1>(sc, history, taken);
+    }
+
+    // Brings the folds to `h`: one shift when a branch was appended, else a refold
+    // (e.g. when a flush restored the history).
+    void sync(uint64_t h) {
+      if (h == history) {
+        return;
+      }
+      if (((history << 1) | (h & 1)) == h) {
+        shift(std::make_index_sequence<TABLES>{}, h & 1);
+      } else {
+        for (size_t t = 0; t < TABLES; ++t) {
+          index[t] = fold_history(h, HISTORY_LENGTHS[t], INDEX_BITS);
+          tag[t] = fold_history(h, HISTORY_LENGTHS[t], TAG_BITS);
+          tag_short[t] = fold_history(h, HISTORY_LENGTHS[t], TAG_BITS - 1);
+        }
+        sc = fold_history(h, SC_HISTORY_LENGTH, SC_BITS - 1);
+      }
+      history = h;
+    }
+  };
+
+  struct Lookup {
+    std::array<size_t, TABLES> index;
+    std::array<uint16_t, TABLES> tag;
+    int provider = -1;
+    int alt = -1;
+    bool provider_pred = false;
+    bool alt_pred = false;
+    bool use_alt = false;
+    bool tage_pred = false;
+  };
+
+  std::array<uint8_t, BASE_ENTRIES> base;
+  std::array<std::array<TaggedEntry, 1u << INDEX_BITS>, TABLES> tagged{};
+  int8_t use_alt_on_new = 0; // 4-bit signed
+  uint64_t update_count = 0;
+
+  std::array<int8_t, 1u << SC_BITS> sc_bias{};
+  std::array<int8_t, 1u << SC_BITS> sc_history{};
+
+  std::array<LoopEntry, LOOP_ENTRIES> loops{};
+
+  Folds spec_folds;    // of the history passed to predict()
+  Folds retired_folds; // of the history passed to update()
+
+  uint64_t& sc_flips;
+  uint64_t& loop_predictions;
+
+  bool base_pred(PCType pc) const { return base[(pc >> 2) & (BASE_ENTRIES - 1)] >= 2; }
+
+  Lookup lookup(PCType pc, const Folds& f) const {
+    Lookup l;
+    const uint32_t p = pc >> 2;
+    for (size_t t = 0; t < TABLES; ++t) {
+      l.index[t] = (p ^ (p >> (INDEX_BITS - t)) ^ f.index[t]) & ((1u << INDEX_BITS) - 1);
+      const uint32_t tag = p ^ f.tag[t] ^ (f.tag_short[t] << 1);
+      l.tag[t] = static_cast<uint16_t>(tag & ((1u << TAG_BITS) - 1));
+      if (l.tag[t] == 0) l.tag[t] = 1;
+    }
+    for (int t = TABLES - 1; t >= 0; --t) {
+      if (tagged[t][l.index[t]].tag == l.tag[t]) {
+        if (l.provider < 0) {
+          l.provider = t;
+        } else {
+          l.alt = t;
+          break;
+        }
+      }
+    }
+    l.alt_pred = l.alt >= 0 ? tagged[l.alt][l.index[l.alt]].counter >= 0 : base_pred(pc);
+    if (l.provider < 0) {
+      l.tage_pred = l.alt_pred;
+      return l;
+    }
+    const TaggedEntry& e = tagged[l.provider][l.index[l.provider]];
+    l.provider_pred = e.counter >= 0;
+    const bool weak_new = (e.counter == 0 || e.counter == -1) && e.useful == 0;
+    l.use_alt = weak_new && use_alt_on_new >= 0;
+    l.tage_pred = l.use_alt ? l.alt_pred : l.provider_pred;
+    return l;
+  }
+
+  // TAGE's confidence as a signed vote for the SC sum.
+  int tage_vote(const Lookup& l, PCType pc) const {
+    int centered;
+    if (l.provider >= 0 && !l.use_alt) {
+      centered = 2 * tagged[l.provider][l.index[l.provider]].counter + 1;
+    } else {
+      centered = 2 * static_cast<int>(base[(pc >> 2) & (BASE_ENTRIES - 1)]) - 3;
+    }
+    return centered * 2;
+  }
+
+  size_t sc_bias_index(PCType pc, bool tage_pred) const {
+    return (((pc >> 2) << 1) | tage_pred) & ((1u << SC_BITS) - 1);
+  }
+  size_t sc_history_index(PCType pc, const Folds& f, bool tage_pred) const {
+    return ((((pc >> 2) ^ f.sc) << 1) | tage_pred) & ((1u << SC_BITS) - 1);
+  }
+
+  int sc_sum(PCType pc, const Folds& f, const Lookup& l) const {
+    return 2 * sc_bias[sc_bias_index(pc, l.tage_pred)] + 1 +
+           2 * sc_history[sc_history_index(pc, f, l.tage_pred)] + 1 + tage_vote(l, pc);
+  }
+
+  LoopEntry* find_loop(PCType pc) {
+    LoopEntry& e = loops[(pc >> 2) % LOOP_ENTRIES];
+    const uint16_t tag = static_cast<uint16_t>((pc >> 8) | 1);
+    return e.tag == tag ? &e : nullptr;
+  }
+
+  void update_loop(PCType pc, bool taken, bool mispredicted) {
+    LoopEntry* e = find_loop(pc);
+    if (!e) {
+      // Learn loops whose exit was mispredicted.
+      if (mispredicted && !taken) {
+        loops[(pc >> 2) % LOOP_ENTRIES] = LoopEntry{.tag = static_cast<uint16_t>((pc >> 8) | 1)};
+      }
+      return;
+    }
+    if (taken) {
+      if (e->retired_iter == UINT16_MAX) {
+        *e = LoopEntry{}; // not a loop we can count
+        return;
+      }
+      ++e->retired_iter;
+      return;
+    }
+    if (e->retired_iter == e->trip && e->trip > 0) {
+      if (e->confidence < LOOP_CONFIDENT) ++e->confidence;
+    } else {
+      e->trip = e->retired_iter;
+      e->confidence = 0;
+    }
+    e->retired_iter = 0;
+  }
+
+public:
+  TageScLPredictor()
+      : sc_flips(Stats::getInstance().counter("tage.sc_flips")),
+        loop_predictions(Stats::getInstance().counter("tage.loop_predictions")) {
+    base.fill(1);
+  }
+
+  const char* name() const override { return "tage"; }
+
+  bool predict(PCType pc, uint64_t history) override {
+    spec_folds.sync(history);
+    const Lookup l = lookup(pc, spec_folds);
+    bool prediction = l.tage_pred;
+
+    const int sum = sc_sum(pc, spec_folds, l);
+    if ((sum >= 0) != prediction && std::abs(sum) >= SC_THRESHOLD) {
+      prediction = sum >= 0;
+      ++sc_flips;
+    }
+
+    if (LoopEntry* e = find_loop(pc)) {
+      if (e->confidence >= LOOP_CONFIDENT) {
+        prediction = e->spec_iter < e->trip;
+        ++loop_predictions;
+      }
+      e->spec_iter = prediction ? e->spec_iter + 1 : 0;
+    }
+    return prediction;
+  }
+
+  void update(PCType pc, uint64_t history, bool taken) override {
+    retired_folds.sync(history);
+    const Lookup l = lookup(pc, retired_folds);
+
+    // Statistical corrector.
+    const int sum = sc_sum(pc, retired_folds, l);
+    const bool sc_pred = std::abs(sum) >= SC_THRESHOLD ? sum >= 0 : l.tage_pred;
+    if (sc_pred != taken || std::abs(sum) < SC_THRESHOLD * 2) {
+      saturate_step<int8_t>(sc_bias[sc_bias_index(pc, l.tage_pred)], taken, -32, 31);
+      saturate_step<int8_t>(sc_history[sc_history_index(pc, retired_folds, l.tage_pred)], taken, -32, 31);
+    }
+
+    update_loop(pc, taken, sc_pred != taken);
+
+    // TAGE.
+    if (l.provider >= 0) {
+      TaggedEntry& e = tagged[l.provider][l.index[l.provider]];
+      const bool weak_new = (e.counter == 0 || e.counter == -1) && e.useful == 0;
+      if (weak_new && l.provider_pred != l.alt_pred) {
+        saturate_step<int8_t>(use_alt_on_new, l.alt_pred == taken, -8, 7);
+      }
+      saturate_step<int8_t>(e.counter, taken, -4, 3);
+      if (l.provider_pred != l.alt_pred) {
+        saturate_step<uint8_t>(e.useful, l.provider_pred == taken, 0, 3);
+      }
+      if (l.alt < 0 && weak_new) {
+        saturate_step<uint8_t>(base[(pc >> 2) & (BASE_ENTRIES - 1)], taken, 0, 3);
+      }
+    } else {
+      saturate_step<uint8_t>(base[(pc >> 2) & (BASE_ENTRIES - 1)], taken, 0, 3);
+    }
+
+    if (l.tage_pred != taken && l.provider < static_cast<int>(TABLES) - 1) {
+      bool allocated = false;
+      for (size_t t = static_cast<size_t>(l.provider + 1); t < TABLES; ++t) {
+        TaggedEntry& e = tagged[t][l.index[t]];
+        if (e.useful == 0) {
+          e = TaggedEntry{.counter = static_cast<int8_t>(taken ? 0 : -1), .useful = 0, .tag = l.tag[t]};
+          allocated = true;
+          break;
+        }
+      }
+      if (!allocated) {
+        for (size_t t = static_cast<size_t>(l.provider + 1); t < TABLES; ++t) {
+          TaggedEntry& e = tagged[t][l.index[t]];
+          if (e.useful > 0) --e.useful;
+        }
+      }
+    }
+
+    if (++update_count % USEFUL_RESET_PERIOD == 0) {
+      for (auto& table : tagged) {
+        for (TaggedEntry& e : table) {
+          e.useful >>= 1;
+        }
+      }
+    }
+  }
+
+  void repair() override {
+    spec_folds = retired_folds;
+    for (LoopEntry& e : loops) {
+      e.spec_iter = e.retired_iter;
+    }
+  }
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "constants.hpp"
+#include "instruction.hpp"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+/**
+ * @class ReturnAddressStack
+ * @brief Fixed-depth circular stack of return addresses.
+ *
+ * Pushing onto a full stack overwrites the oldest entry, so deep recursion loses its
+ * outermost returns instead of the innermost ones. The stack is plain data: the
+ * Decoder keeps a speculative copy updated at decode and a retired copy updated at
+ * commit, and repairs the former by assignment on a pipeline flush.
+ */
+template <size_t N>
+class ReturnAddressStack {
+  std::array<PCType, N> entries{};
+  size_t top = 0;   // index of the next push
+  size_t count = 0;
+
+public:
+  void push(PCType return_pc) {
+    entries[top] = return_pc;
+    top = (top + 1) % N;
+    if (count < N) {
+      ++count;
+    }
+  }
+
+  std::optional<PCType> pop() {
+    if (count == 0) {
+      return std::nullopt;
+    }
+    top = (top + N - 1) % N;
+    --count;
+    return entries[top];
+  }
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * RV32C: expansion of 16-bit compressed instructions into the RV32I words they stand
+ * for, so the decoder only has to understand one encoding. An instruction is 16 bits
+ * long exactly when its low two bits are not 0b11.
+ */
+constexpr bool is_compressed(uint32_t word) { return (word & 0b11) != 0b11; }
+
+namespace rvc {
+
+constexpr uint32_t bits(uint32_t v, int hi, int lo) { return (v >> lo) & ((1u << (hi - lo + 1)) - 1); }
+
+// Sign-extends the low `width` bits.
+constexpr uint32_t sext(uint32_t v, int width) {
+  return static_cast<uint32_t>(static_cast<int32_t>(v << (32 - width)) >> (32 - width));
+}
+
+// The x8-x15 register of a 3-bit field.
+constexpr uint32_t creg(uint32_t v) { return 8 + v; }
+
+constexpr uint32_t i_type(uint32_t imm, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode) {
+  return (imm & 0xFFF) << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | opcode;
+}
+constexpr uint32_t r_type(uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t rd) {
+  return funct7 << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | 0b0110011;
+}
+constexpr uint32_t s_type(uint32_t imm, uint32_t rs2, uint32_t rs1) {
+  return bits(imm, 11, 5) << 25 | rs2 << 20 | rs1 << 15 | 0b010 << 12 | bits(imm, 4, 0) << 7 | 0b0100011;
+}
+constexpr uint32_t b_type(uint32_t imm, uint32_t rs1, uint32_t funct3) {
+  return bits(imm, 12, 12) << 31 | bits(imm, 10, 5) << 25 | rs1 << 15 | funct3 << 12 |
+         bits(imm, 4, 1) << 8 | bits(imm, 11, 11) << 7 | 0b1100011;
+}
+constexpr uint32_t j_type(uint32_t imm, uint32_t rd) {
+  return bits(imm, 20, 20) << 31 | bits(imm, 10, 1) << 21 | bits(imm, 11, 11) << 20 |
+         bits(imm, 19, 12) << 12 | rd << 7 | 0b1101111;
+}
+
+constexpr uint32_t OP_IMM = 0b0010011, LOAD = 0b0000011, JALR = 0b1100111, LUI = 0b0110111;
+
+// CJ-format jump offset.
+constexpr uint32_t cj_offset(uint32_t c) {
+  return sext(bits(c, 12, 12) << 11 | bits(c, 8, 8) << 10 | bits(c, 10, 9) << 8 | bits(c, 6, 6) << 7 |
+                  bits(c, 7, 7) << 6 | bits(c, 2, 2) << 5 | bits(c, 11, 11) << 4 | bits(c, 5, 3) << 1,
+              12);
+}
+
+// CI-format 6-bit immediate.
+constexpr uint32_t ci_imm(uint32_t c) { return sext(bits(c, 12, 12) << 5 | bits(c, 6, 2), 6); }
+
+constexpr uint32_t quadrant0(uint32_t c) {
+  const uint32_t rd = creg(bits(c, 4, 2));
+  const uint32_t rs1 = creg(bits(c, 9, 7));
+  const uint32_t lw_offset = bits(c, 5, 5) << 6 | bits(c, 12, 10) << 3 | bits(c, 6, 6) << 2;
+  switch (bits(c, 15, 13)) {
+  case 0b000: { // C.ADDI4SPN
+    const uint32_t imm = bits(c, 10, 7) << 6 | bits(c, 12, 11) << 4 | bits(c, 5, 5) << 3 | bits(c, 6, 6) << 2;
+    return imm == 0 ? 0 : i_type(imm, 2, 0b000, rd, OP_IMM);
+  }
+  case 0b010: return i_type(lw_offset, rs1, 0b010, rd, LOAD); // C.LW
+  case 0b110: return s_type(lw_offset, rd, rs1);              // C.SW
+  default: return 0;
+  }
+}
+
+constexpr uint32_t quadrant1(uint32_t c) {
+  const uint32_t rd = bits(c, 11, 7);
+  const uint32_t rd_c = creg(bits(c, 9, 7));
+  const uint32_t rs2_c = creg(bits(c, 4, 2));
+  switch (bits(c, 15, 13)) {
+  case 0b000: return i_type(ci_imm(c), rd, 0b000, rd, OP_IMM); // C.ADDI, C.NOP
+  case 0b001: return j_type(cj_offset(c), 1);                  // C.JAL
+  case 0b010: return i_type(ci_imm(c), 0, 0b000, rd, OP_IMM);  // C.LI
+  case 0b011:
+    if (rd == 2) { // C.ADDI16SP
+      const uint32_t imm = sext(bits(c, 12, 12) << 9 | bits(c, 4, 3) << 7 | bits(c, 5, 5) << 6 |
+                                    bits(c, 2, 2) << 5 | bits(c, 6, 6) << 4,
+                                10);
+      return imm == 0 ? 0 : i_type(imm, 2, 0b000, 2, OP_IMM);
+    }
+    if (ci_imm(c) == 0) return 0;
+    return (ci_imm(c) << 12) | rd << 7 | LUI; // C.LUI
+  case 0b100:
+    switch (bits(c, 11, 10)) {
+    case 0b00: return bits(c, 12, 12) ? 0 : i_type(bits(c, 6, 2), rd_c, 0b101, rd_c, OP_IMM);           // C.SRLI
+    case 0b01: return bits(c, 12, 12) ? 0 : i_type(0x400 | bits(c, 6, 2), rd_c, 0b101, rd_c, OP_IMM);   // C.SRAI
+    case 0b10: return i_type(ci_imm(c), rd_c, 0b111, rd_c, OP_IMM);                                     // C.ANDI
+    default:
+      if (bits(c, 12, 12)) return 0;
+      switch (bits(c, 6, 5)) {
+      case 0b00: return r_type(0x20, rs2_c, rd_c, 0b000, rd_c); // C.SUB
+      case 0b01: return r_type(0, rs2_c, rd_c, 0b100, rd_c);    // C.XOR
+      case 0b10: return r_type(0, rs2_c, rd_c, 0b110, rd_c);    // C.OR
+      default: return r_type(0, rs2_c, rd_c, 0b111, rd_c);      // C.AND
+      }
+    }
+  case 0b101: return j_type(cj_offset(c), 0); // C.J
+  case 0b110:
+  case 0b111: { // C.BEQZ, C.BNEZ
+    const uint32_t offset = sext(bits(c, 12, 12) << 8 | bits(c, 6, 5) << 6 | bits(c, 2, 2) << 5 |
+                                     bits(c, 11, 10) << 3 | bits(c, 4, 3) << 1,
+                                 9);
+    return b_type(offset, rd_c, bits(c, 13, 13));
+  }
+  default: return 0;
+  }
+}
+
+constexpr uint32_t quadrant2(uint32_t c) {
+  const uint32_t rd = bits(c, 11, 7);
+  const uint32_t rs2 = bits(c, 6, 2);
+  switch (bits(c, 15, 13)) {
+  case 0b000: return bits(c, 12, 12) ? 0 : i_type(rs2, rd, 0b001, rd, OP_IMM); // C.SLLI
+  case 0b010: { // C.LWSP
+    const uint32_t offset = bits(c, 3, 2) << 6 | bits(c, 12, 12) << 5 | bits(c, 6, 4) << 2;
+    return rd == 0 ? 0 : i_type(offset, 2, 0b010, rd, LOAD);
+  }
+  case 0b100:
+    if (!bits(c, 12, 12)) {
+      if (rs2 == 0) return rd == 0 ? 0 : i_type(0, rd, 0b000, 0, JALR); // C.JR
+      return r_type(0, rs2, 0, 0b000, rd);                                // C.MV
+    }
+    if (rs2 == 0) return rd == 0 ? 0 : i_type(0, rd, 0b000, 1, JALR); // C.JALR (C.EBREAK when rd == 0)
+    return r_type(0, rs2, rd, 0b000, rd);                              // C.ADD
+  case 0b110: { // C.SWSP
+    const uint32_t offset = bits(c, 8, 7) << 6 | bits(c, 12, 9) << 2;
+    return s_type(offset, rs2, 2);
+  }
+  default: return 0;
+  }
+}
+
+} // namespace rvc
+
+// Returns 0, which is not a valid RV32I word either, for reserved and unsupported
+// encodings (including C.EBREAK and the floating-point loads and stores).
+constexpr uint32_t expand_compressed(uint16_t c) {
+  switch (c & 0b11) {
+  case 0b00: return c == 0 ? 0 : rvc::quadrant0(c); // all zeros is defined illegal
+  case 0b01: return rvc::quadrant1(c);
+  case 0b10: return rvc::quadrant2(c);
+  default: return 0;
+  }
+}
@@ -1,9 +1,11 @@
 #pragma once
 #include "constants.hpp"
+#include "utils/bundle.hpp"
+#include <array>
 #include <ostream> // Required for std::ostream
 #include <string>  // Required for std::string
 
-enum class OpType {
+enum class OpType : uint8_t {
   // R-Type
   ADD,
   SUB,
@@ -60,50 +62,80 @@ enum class OpType {
   INVALID // For decoding errors
 };
 
-// Function to convert OpType to a string representation
-inline const char *to_string(OpType op) {
-  switch (op) {
-  case OpType::ADD: return "ADD";
-  case OpType::SUB: return "SUB";
-  case OpType::OR: return "OR";
-  case OpType::XOR: return "XOR";
-  case OpType::AND: return "AND";
-  case OpType::SLL: return "SLL";
-  case OpType::SRL: return "SRL";
-  case OpType::SRA: return "SRA";
-  case OpType::SLT: return "SLT";
-  case OpType::SLTU: return "SLTU";
-  case OpType::ADDI: return "ADDI";
-  case OpType::ANDI: return "ANDI";
-  case OpType::ORI: return "ORI";
-  case OpType::XORI: return "XORI";
-  case OpType::SLLI: return "SLLI";
-  case OpType::SRLI: return "SRLI";
-  case OpType::SRAI: return "SRAI";
-  case OpType::SLTI: return "SLTI";
-  case OpType::SLTIU: return "SLTIU";
-  case OpType::LW: return "LW";
-  case OpType::LH: return "LH";
-  case OpType::LHU: return "LHU";
-  case OpType::LB: return "LB";
-  case OpType::LBU: return "LBU";
-  case OpType::JALR: return "JALR";
-  case OpType::SW: return "SW";
-  case OpType::SH: return "SH";
-  case OpType::SB: return "SB";
-  case OpType::BEQ: return "BEQ";
-  case OpType::BNE: return "BNE";
-  case OpType::BLT: return "BLT";
-  case OpType::BGE: return "BGE";
-  case OpType::BLTU: return "BLTU";
-  case OpType::BGEU: return "BGEU";
-  case OpType::LUI: return "LUI";
-  case OpType::AUIPC: return "AUIPC";
-  case OpType::JAL: return "JAL";
-  // Default
-  case OpType::INVALID: return "INVALID";
-  default: return "UNKNOWN";
+// Which reservation station an instruction is dispatched to.
+enum class UnitClass : uint8_t { ALU, MEM, BRANCH, NONE };
+
+// Static properties of an operation, looked up by OpType.
+struct OpTraits {
+  OpType op;
+  const char *name;
+  UnitClass unit;
+  uint8_t mem_size; // bytes accessed, 0 for non-memory ops
+  bool is_load;
+  bool is_store;
+  bool is_signed;   // loads: sign-extend the value read
+  bool writes_rd;
+};
+
+inline constexpr size_t OP_COUNT = static_cast<size_t>(OpType::INVALID) + 1;
+
+// One row per OpType, in declaration order.
+inline constexpr std::array<OpTraits, OP_COUNT> OP_TRAITS = {{
+    // op, name, unit, mem_size, is_load, is_store, is_signed, writes_rd
+    {OpType::ADD,     "ADD",    UnitClass::ALU,    0, false, false, false, true},
+    {OpType::SUB,     "SUB",    UnitClass::ALU,    0, false, false, false, true},
+    {OpType::OR,      "OR",     UnitClass::ALU,    0, false, false, false, true},
+    {OpType::XOR,     "XOR",    UnitClass::ALU,    0, false, false, false, true},
+    {OpType::AND,     "AND",    UnitClass::ALU,    0, false, false, false, true},
+    {OpType::SLL,     "SLL",    UnitClass::ALU,    0, false, false, false, true},
+    {OpType::SRL,     "SRL",    UnitClass::ALU,    0, false, false, false, true},
+    {OpType::SRA,     "SRA",    UnitClass::ALU,    0, false, false, false, true},
+    {OpType::SLT,     "SLT",    UnitClass::ALU,    0, false, false, false, true},
+    {OpType::SLTU,    "SLTU",   UnitClass::ALU,    0, false, false, false, true},
+    {OpType::ADDI,    "ADDI",   UnitClass::ALU,    0, false, false, false, true},
+    {OpType::ANDI,    "ANDI",   UnitClass::ALU,    0, false, false, false, true},
+    {OpType::ORI,     "ORI",    UnitClass::ALU,    0, false, false, false, true},
+    {OpType::XORI,    "XORI",   UnitClass::ALU,    0, false, false, false, true},
+    {OpType::SLLI,    "SLLI",   UnitClass::ALU,    0, false, false, false, true},
+    {OpType::SRLI,    "SRLI",   UnitClass::ALU,    0, false, false, false, true},
+    {OpType::SRAI,    "SRAI",   UnitClass::ALU,    0, false, false, false, true},
+    {OpType::SLTI,    "SLTI",   UnitClass::ALU,    0, false, false, false, true},
+    {OpType::SLTIU,   "SLTIU",  UnitClass::ALU,    0, false, false, false, true},
+    {OpType::LW,      "LW",     UnitClass::MEM,    4, true,  false, true,  true},
+    {OpType::LH,      "LH",     UnitClass::MEM,    2, true,  false, true,  true},
+    {OpType::LHU,     "LHU",    UnitClass::MEM,    2, true,  false, false, true},
+    {OpType::LB,      "LB",     UnitClass::MEM,    1, true,  false, true,  true},
+    {OpType::LBU,     "LBU",    UnitClass::MEM,    1, true,  false, false, true},
+    {OpType::JALR,    "JALR",   UnitClass::BRANCH, 0, false, false, false, true},
+    {OpType::SW,      "SW",     UnitClass::MEM,    4, false, true,  false, false},
+    {OpType::SH,      "SH",     UnitClass::MEM,    2, false, true,  false, false},
+    {OpType::SB,      "SB",     UnitClass::MEM,    1, false, true,  false, false},
+    {OpType::BEQ,     "BEQ",    UnitClass::BRANCH, 0, false, false, false, false},
+    {OpType::BNE,     "BNE",    UnitClass::BRANCH, 0, false, false, false, false},
+    {OpType::BLT,     "BLT",    UnitClass::BRANCH, 0, false, false, false, false},
+    {OpType::BGE,     "BGE",    UnitClass::BRANCH, 0, false, false, false, false},
+    {OpType::BLTU,    "BLTU",   UnitClass::BRANCH, 0, false, false, false, false},
+    {OpType::BGEU,    "BGEU",   UnitClass::BRANCH, 0, false, false, false, false},
+    {OpType::LUI,     "LUI",    UnitClass::ALU,    0, false, false, false, true},
+    {OpType::AUIPC,   "AUIPC",  UnitClass::ALU,    0, false, false, false, true},
+    {OpType::JAL,     "JAL",    UnitClass::BRANCH, 0, false, false, false, true},
+    {OpType::INVALID, "INVALID", UnitClass::NONE,  0, false, false, false, false},
+}};
+
+consteval bool op_traits_in_order() {
+  for (size_t i = 0; i < OP_COUNT; ++i) {
+    if (static_cast<size_t>(OP_TRAITS[i].op) != i) return false;
   }
+  return true;
+}
+static_assert(op_traits_in_order(), "OP_TRAITS rows must follow the OpType declaration order");
+
+constexpr const OpTraits &op_traits(OpType op) {
+  return OP_TRAITS[static_cast<size_t>(op)];
+}
+
+inline const char *to_string(OpType op) {
+  return static_cast<size_t>(op) < OP_COUNT ? op_traits(op).name : "UNKNOWN";
 }
 
 // Overload the << operator for easy printing of OpType
@@ -112,92 +144,69 @@ inline std::ostream &operator<<(std::ostream &os, OpType op) {
   return os;
 }
 
-inline bool is_alu(OpType op) {
-  switch (op) {
-  case OpType::ADD:
-  case OpType::SUB:
-  case OpType::OR:
-  case OpType::XOR:
-  case OpType::AND:
-  case OpType::SLL:
-  case OpType::SRL:
-  case OpType::SRA:
-  case OpType::SLT:
-  case OpType::SLTU:
-  case OpType::ADDI:
-  case OpType::ANDI:
-  case OpType::ORI:
-  case OpType::XORI:
-  case OpType::SLLI:
-  case OpType::SRLI:
-  case OpType::SRAI:
-  case OpType::SLTI:
-  case OpType::SLTIU:
-  case OpType::AUIPC:
-  case OpType::LUI:
-    return true;
-  default:
-    return false;
-  }
+constexpr bool is_alu(OpType op) { return op_traits(op).unit == UnitClass::ALU; }
+constexpr bool is_mem(OpType op) { return op_traits(op).unit == UnitClass::MEM; }
+// Conditional branches and both jumps.
+constexpr bool is_branch(OpType op) { return op_traits(op).unit == UnitClass::BRANCH; }
+constexpr bool is_conditional_branch(OpType op) {
+  return is_branch(op) && op != OpType::JAL && op != OpType::JALR;
 }
 
-inline bool is_mem(OpType op) {
-  switch (op) {
-  case OpType::LW:
-  case OpType::LH:
-  case OpType::LHU:
-  case OpType::LB:
-  case OpType::LBU:
-  case OpType::SW:
-  case OpType::SH:
-  case OpType::SB:
-    return true;
-  default:
-    return false;
-  }
+// The PC after an instruction that falls through, i.e. its link address.
+constexpr PCType fallthrough_pc(PCType pc, bool compressed) { return pc + (compressed ? 2 : 4); }
+
+// x1 (ra) and x5 (t0) are the link registers of the RISC-V calling convention.
+constexpr bool is_link_reg(RegIDType r) { return r == 1 || r == 5; }
+
+// A jump that writes a link register.
+constexpr bool is_call(OpType op, RegIDType rd) {
+  return (op == OpType::JAL || op == OpType::JALR) && is_link_reg(rd);
 }
 
-inline bool is_branch(OpType op) {
-  switch (op) {
-  case OpType::BEQ:
-  case OpType::BNE:
-  case OpType::BLT:
-  case OpType::BGE:
-  case OpType::BLTU:
-  case OpType::BGEU:
-  case OpType::JAL:
-  case OpType::JALR:
-    return true;
-  default:
-    return false;
-  }
+// A JALR through a link register that does not also write it (`jalr x0, ra`).
+constexpr bool is_return(OpType op, RegIDType rd, RegIDType rs1) {
+  return op == OpType::JALR && is_link_reg(rs1) && rd != rs1;
 }
 
 struct Instruction {
-  OpType op = OpType::INVALID;
   PCType pc = 0;
+  RegDataType imm = 0;
+  PCType predicted_next_pc = 0; // where the frontend continued fetching
 
+  OpType op = OpType::INVALID;
   RegIDType rd = 0;
   RegIDType rs1 = 0;
   RegIDType rs2 = 0;
 
-  RegDataType imm = 0;
-
-  bool is_branch = false;
-  bool predicted_taken = false;
+  bool is_branch : 1 = false;
+  bool predicted_taken : 1 = false;
+  bool fused : 1 = false; // a macro-op; the first of its pair is at pc - 4 (frontend/fusion.hpp)
+  bool compressed : 1 = false; // a 16-bit RV32C encoding
 };
+static_assert(sizeof(Instruction) == 20, "Instruction grew; it is copied at every stage");
+
+// Whether `ins` produces a register value. A fused compare-and-branch writes its
+// comparison to rd even though a plain branch does not (frontend/fusion.hpp).
+constexpr bool writes_register(const Instruction &ins) {
+  return ins.rd != 0 && (op_traits(ins.op).writes_rd || ins.fused);
+}
 
 
 struct FilledInstruction {
   Instruction ins;
-  RobIDType id;
   RegDataType v_rs1 = 0;
   RegDataType v_rs2 = 0;
+  RobIDType id;
   RobIDType q_rs1 = 0;
   RobIDType q_rs2 = 0;
   FilledInstruction() = default;
   FilledInstruction(Instruction ins,  RobIDType id):ins(ins),id(id) {}
 };
+static_assert(sizeof(FilledInstruction) == 36, "FilledInstruction grew; it is copied at every stage");
+
+// The instructions decoded in one cycle, in program order: a fetch block, plus the
+// instruction the decoder held back from the previous block for fusion.
+using InstructionBundle = Bundle<Instruction, FETCH_BLOCK_MAX_INSTRUCTIONS + 1>;
 #include <sstream>
 
 inline std::string to_string(const Instruction &ins) {
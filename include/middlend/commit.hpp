@@ -4,9 +4,10 @@
 #include "middlend/reg.hpp"
 #include "backend/cdb.hpp"
 #include "backend/units/branch.hpp"
-#include <iostream> // For std::cout
 #include <string>   // For std::string
+#include <optional>
 #include "utils/reg_dump.hpp" // For RegisterDumper
+#include "cosim/lockstep.hpp"
 
 class Committer {
 private:
@@ -15,11 +16,11 @@ private:
 
     WritePort<CDBResult>& rob_cdb_port_;
     WritePort<BranchResult>& rob_branch_port_;
-    ReadPort<bool, std::optional<ROBEntry>> rob_head_port_;
+    ReorderBuffer::FrontPort rob_head_port_;
     WritePort<bool>& rob_pop_port_;
 
     WritePort<FillRequest>& reg_fill_port_;
-    ReadPort<RegIDType, std::pair<RegDataType, RobIDType>> reg_get_port_; // For reading a0 on HALT
+    RegisterFile::GetPort reg_get_port_; // For reading a0 on HALT
 
     Bus<ROBEntry>& commit_bus_;
     Bus<bool>& flush_bus_;
@@ -28,7 +29,12 @@ private:
 
     //only for dump
     RegisterFile& reg_;
+    const ReorderBuffer& rob_;
     norb::RegisterDumper<32, RegDataType> dumper_;
+    LockstepChecker& checker_;
+
+    std::optional<RegDataType> halt_value_;
+    uint64_t committed_count_ = 0;
 
 public:
     Committer(
@@ -38,10 +44,12 @@ public:
         Channel<BranchResult>& branch_result_channel,
         Bus<ROBEntry>& commit_bus,
         Bus<bool>& flush_bus,
-        Channel<PCType>& flush_pc_channel
+        Channel<PCType>& flush_pc_channel,
+        LockstepChecker& checker
     ) :
         cdb_(cdb),
         reg_(reg),
+        rob_(rob),
         branch_result_channel_(branch_result_channel),
         // Wire up the ports
         rob_cdb_port_(rob.create_cdb_port()),
@@ -53,7 +61,8 @@ public:
         commit_bus_(commit_bus),
         flush_bus_(flush_bus),
         flush_pc_channel_(flush_pc_channel),
-        dumper_("../dump/my.dump") // Initialize the dumper
+        dumper_("../dump/my.dump"), // Initialize the dumper
+        checker_(checker)
     {
         Clock::getInstance().subscribe([this] { this->work(); });
     }
@@ -82,10 +91,12 @@ public:
         const auto& head_entry = *head_entry_opt;
 
         if (head_entry.state == ISHALT) {
-            auto a0_state = reg_get_port_.read(10);
-            RegDataType a0_value = a0_state.first;
-            std::cout << (a0_value & 0xff) << std::endl;
-            exit(0);
+            if (!halt_value_) {
+                checker_.on_halt(head_entry, reg_, rob_);
+                auto a0_state = reg_get_port_.read(10);
+                halt_value_ = a0_state.first;
+            }
+            return;
         }
 
         if (head_entry.state == COMMIT_READY) {
@@ -97,10 +108,18 @@ public:
 
             // ----DUMP Logic----
             auto reg_snapshot = reg_.get_snapshot();
+            if (commit_result.fused) {
+                // One record per instruction: the first of the pair with its own result.
+                if (commit_result.reg_id != 0) {
+                    reg_snapshot[commit_result.reg_id] = fused_head_value(commit_result);
+                }
+                dumper_.dump(commit_result.pc - 4, reg_snapshot);
+            }
             if (commit_result.reg_id != 0) {
                 reg_snapshot[commit_result.reg_id] = commit_result.value;
             }
             dumper_.dump(commit_result.pc, reg_snapshot);
+            checker_.on_commit(commit_result, reg_, rob_);
             // --- END DUMP LOGIC ---
 
             if (commit_result.reg_id != 0) {
@@ -109,12 +128,40 @@ public:
 
             commit_bus_.send(commit_result);
 
-            if (is_branch(commit_result.type) && commit_result.predicted_taken != commit_result.is_taken) {
-                PCType correct_pc = commit_result.is_taken ? commit_result.target_pc : (commit_result.pc + 4);
+            if (commit_result.is_branch && commit_result.mispredicted) {
+                PCType correct_pc = commit_result.is_taken ? commit_result.target_pc
+                                                           : fallthrough_pc(commit_result.pc, commit_result.compressed);
                 flush_pc_channel_.send(correct_pc);
                 flush_bus_.send(true);
             }
             rob_pop_port_.push(true);
+            committed_count_ += commit_result.fused ? 2 : 1;
         }
     }
+
+    bool halted() const { return halt_value_.has_value(); }
+
+    /// @brief The value of a0 when the halt instruction reached the ROB head.
+    RegDataType exit_value() const { return halt_value_.value_or(0); }
+
+    uint64_t committed_count() const { return committed_count_; }
+
+private:
+    // What the first of a fused pair (frontend/fusion.hpp) wrote to rd. A compare-and-branch's
+    // value is the comparison itself. For the others the second instruction added a
+    // sign-extended 12-bit immediate to a multiple of 0x1000, which rounding undoes: in the
+    // value of lui+addi, or in the jump target or load address of an auipc pair relative to
+    // the auipc's PC.
+    static RegDataType fused_head_value(const ROBEntry& e) {
+        if (is_conditional_branch(e.type)) {
+            return e.value;
+        }
+        if (e.type == OpType::LUI) {
+            return upper_part(e.value);
+        }
+        const PCType head_pc = e.pc - 4;
+        return head_pc + upper_part(e.target_pc - head_pc);
+    }
+
+    static RegDataType upper_part(RegDataType sum) { return (sum + 0x800) & ~RegDataType{0xFFF}; }
 };
\ No newline at end of file
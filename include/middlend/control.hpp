@@ -28,7 +28,7 @@ private:
 public:
     Controller(
 
-        Channel<Instruction>& ins_channel,
+        Channel<InstructionBundle>& ins_channel,
         Channel<BranchResult>& branch_result_channel,
         CommonDataBus& cdb,
 
@@ -37,7 +37,8 @@ public:
         Channel<FilledInstruction>& branch_channel,
         Bus<ROBEntry>& commit_bus,
         Bus<bool>& flush_bus,
-        Channel<PCType>& flush_pc_channel
+        Channel<PCType>& flush_pc_channel,
+        LockstepChecker& checker
     ) :
         flush_bus_(flush_bus)
     {
@@ -49,7 +50,8 @@ public:
             branch_result_channel,
             commit_bus,
             flush_bus_,
-            flush_pc_channel
+            flush_pc_channel,
+            checker
         );
 
         
@@ -80,6 +82,10 @@ public:
         
     }
 
+    bool halted() const { return committer_->halted(); }
+    RegDataType exit_value() const { return committer_->exit_value(); }
+    uint64_t committed_count() const { return committer_->committed_count(); }
+
     /**
      * @brief Provides a read-only snapshot of the architectural registers for testing/debugging.
      * @return A const reference to the register array.
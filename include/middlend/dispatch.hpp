@@ -7,16 +7,26 @@
 
 class Dispatcher {
 private:
-    Channel<Instruction>& ins_channel_;
+    // Moves past the instruction just dispatched, releasing the bundle after its last.
+    void advance() {
+        if (++bundle_cursor_ == ins_channel_.peek()->size()) {
+            ins_channel_.receive();
+            bundle_cursor_ = 0;
+        }
+    }
+
+    // Decode delivers a bundle per cycle; dispatch is scalar and walks it with a cursor.
+    Channel<InstructionBundle>& ins_channel_;
+    size_t bundle_cursor_ = 0;
     CommonDataBus& cdb_;
-    ReadPort<bool, bool> rob_stall_port_;
-    ReadPort<bool, RobIDType> rob_next_id_port_;
+    ReorderBuffer::StallPort rob_stall_port_;
+    ReorderBuffer::NextIdPort rob_next_id_port_;
 
-    ReadPort<RegIDType, std::pair<RegDataType, RobIDType>> reg_get_port_rs1_;
-    ReadPort<RegIDType, std::pair<RegDataType, RobIDType>> reg_get_port_rs2_;
+    RegisterFile::GetPort reg_get_port_rs1_;
+    RegisterFile::GetPort reg_get_port_rs2_;
 
-    ReadPort<RobIDType, std::optional<RegDataType>> rob_bypass_port_rs1_;
-    ReadPort<RobIDType, std::optional<RegDataType>> rob_bypass_port_rs2_;
+    ReorderBuffer::GetPort rob_bypass_port_rs1_;
+    ReorderBuffer::GetPort rob_bypass_port_rs2_;
 
     WritePort<ROBEntry>& rob_allocate_port_;
     WritePort<PresetRequest>& reg_preset_port_;
@@ -28,7 +38,7 @@ private:
 
 public:
     Dispatcher(
-        Channel<Instruction>& ins_channel,
+        Channel<InstructionBundle>& ins_channel,
         CommonDataBus& cdb,
         ReorderBuffer& rob,
         RegisterFile& reg,
@@ -59,21 +69,23 @@ public:
         if(global_flush_bus_.get()) {
             logger.Warn("RenameDispatch flush initiated.");
             ins_channel_.clear();
+            bundle_cursor_ = 0;
             return;
         }
         if (rob_stall_port_.read(true) || !ins_channel_.peek()) {
             return;
         }
-        Instruction ins = *ins_channel_.peek();
+        Instruction ins = (*ins_channel_.peek())[bundle_cursor_];
         if (!can_dispatch(ins.op) || !rob_allocate_port_.can_push() || !reg_preset_port_.can_push()) {
             return;
         }
 
         bool is_halt_instruction = (ins.op == OpType::ADDI && ins.rd == 10 && ins.rs1 == 0 && ins.imm == 255);
         if (is_halt_instruction) {
-            ins_channel_.receive();
+            advance();
             RobIDType new_rob_id = rob_next_id_port_.read(true);
-            ROBEntry halt_entry = {new_rob_id, ins.op, ins.pc, ins.rd, 0, ISHALT};
+            ROBEntry halt_entry = {.pc = ins.pc, .value = 0, .id = new_rob_id, .type = ins.op,
+                                   .reg_id = ins.rd, .state = ISHALT};
             rob_allocate_port_.push(halt_entry);
             return;
         }
@@ -122,22 +134,36 @@ public:
             }
         }
 
-        ins_channel_.receive();
-        ROBEntry new_entry = {0, ins.op, ins.pc, ins.rd, 0, ISSUED, ins.is_branch, ins.predicted_taken};
+        advance();
+        const bool fused_load = ins.fused && op_traits(ins.op).is_load; // imm is the absolute address
+        ROBEntry new_entry = {.pc = ins.pc, .value = 0,
+                              .target_pc = fused_load ? ins.imm : ins.predicted_next_pc,
+                              .id = 0, .type = ins.op, .reg_id = ins.rd,
+                              .state = ISSUED, .is_branch = ins.is_branch,
+                              .predicted_taken = ins.predicted_taken,
+                              .is_return = is_return(ins.op, ins.rd, ins.rs1), .fused = ins.fused,
+                              .compressed = ins.compressed};
         rob_allocate_port_.push(new_entry);
-        if (ins.rd != 0) {
+        if (writes_register(ins)) {
             reg_preset_port_.push({ins.rd, new_rob_id});
         }
-        if (is_alu(ins.op)) alu_channel_.send(fetched);
-        else if (is_mem(ins.op)) mem_channel_.send(fetched);
-        else if (is_branch(ins.op)) branch_channel_.send(fetched);
+        if (Channel<FilledInstruction>* out = unit_channel(op_traits(ins.op).unit)) {
+            out->send(fetched);
+        }
     }
 
 private:
+    Channel<FilledInstruction>* unit_channel(UnitClass unit) {
+        switch (unit) {
+        case UnitClass::ALU: return &alu_channel_;
+        case UnitClass::MEM: return &mem_channel_;
+        case UnitClass::BRANCH: return &branch_channel_;
+        default: return nullptr;
+        }
+    }
+
     bool can_dispatch(OpType op) {
-        if (is_alu(op)) return alu_channel_.can_send();
-        if (is_mem(op)) return mem_channel_.can_send();
-        if (is_branch(op)) return branch_channel_.can_send();
-        return true;
+        Channel<FilledInstruction>* out = unit_channel(op_traits(op).unit);
+        return out == nullptr || out->can_send();
     }
 };
\ No newline at end of file
@@ -6,7 +6,7 @@
 #include "logger.hpp"
 
 #include <array>
-#include <vector>
+#include <deque>
 #include <utility>
 
 
@@ -27,30 +27,32 @@ private:
     std::array<RegDataType, REG_SIZE> reg{}; 
     std::array<RobIDType, REG_SIZE> rename{};
 
-    std::vector<WritePort<PresetRequest>*> preset_ports;
-    std::vector<WritePort<FillRequest>*> fill_ports;
+    // Write ports are owned here; std::deque keeps the handed-out references stable.
+    std::deque<WritePort<PresetRequest>> preset_ports;
+    std::deque<WritePort<FillRequest>> fill_ports;
+
+    std::pair<RegDataType, RobIDType> _get(RegIDType id) {
+        logger.With("reg", static_cast<int>(id)).With("value", reg[id]).With("ROB_id", rename[id]).Info("RegisterFile read port accessed.");
+        return {reg[id], rename[id]};
+    }
 
 public:
+    using GetPort = ReadPort<&RegisterFile::_get>;
+
     RegisterFile() {
         reg.fill(0);
         rename.fill(0);
         Clock::getInstance().subscribe([this] { this->update_state(); }, FALLING);
     }
 
-    ReadPort<RegIDType, std::pair<RegDataType, RobIDType>> create_get_port() {
-        return ReadPort<RegIDType, std::pair<RegDataType, RobIDType>>(
-            [this](RegIDType id) { return this->_get(id); }
-        );
+    GetPort create_get_port() {
+        return GetPort(*this);
     }
     WritePort<PresetRequest>& create_preset_port() {
-        auto* port = new WritePort<PresetRequest>(); // Simplified memory management
-        preset_ports.push_back(port);
-        return *port;
+        return preset_ports.emplace_back();
     }
     WritePort<FillRequest>& create_fill_port() {
-        auto* port = new WritePort<FillRequest>(); // Simplified memory management
-        fill_ports.push_back(port);
-        return *port;
+        return fill_ports.emplace_back();
     }
 
     void flush() {
@@ -65,22 +67,17 @@ public:
 
 private:
     void update_state() {
-        for (auto* port : preset_ports) {
-            if (auto req = port->consume()) {
+        for (auto& port : preset_ports) {
+            if (auto req = port.consume()) {
                 _preset(req->reg_id, req->rob_id);
             }
         }
-        for (auto* port : fill_ports) {
-            if (auto req = port->consume()) {
+        for (auto& port : fill_ports) {
+            if (auto req = port.consume()) {
                 _fill(req->rob_id, req->reg_id, req->value);
             }
         }
     }
-    std::pair<RegDataType, RobIDType> _get(RegIDType id) {
-        logger.With("reg", static_cast<int>(id)).With("value", reg[id]).With("ROB_id", rename[id]).Info("RegisterFile read port accessed.");
-        return {reg[id], rename[id]};
-    }
-
     void _preset(RegIDType id, RobIDType rob_id) {
         logger.With("reg", static_cast<int>(id)).With("ROB_id", rob_id).Info("RAT preset executed on falling edge.");
         rename[id] = rob_id;
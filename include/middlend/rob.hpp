@@ -5,113 +5,102 @@
 #include "constants.hpp"
 #include "instruction.hpp"
 #include "logger.hpp"
+#include "utils/check.hpp"
 #include "utils/clock.hpp"
 #include "utils/port.hpp"
 #include "utils/queue.hpp"
-#include <vector>
+#include <deque>
 #include <optional>
+#include <ostream>
 
-enum ROBState { ISSUED, COMMIT_READY, ISHALT };
+enum ROBState : uint8_t { ISSUED, COMMIT_READY, ISHALT };
 
 struct ROBEntry {
+  PCType pc;
+  RegDataType value;
+  // The predicted next PC until the branch resolves. A fused load has no use for it and
+  // keeps its address there instead, from which commit recovers the auipc's result.
+  PCType target_pc = 0;
   RobIDType id;
   OpType type;
-  PCType pc;
   RegIDType reg_id;
-  RegDataType value;
   ROBState state = ISSUED;
 
-  bool is_branch = false;
-  bool predicted_taken = false;
-  bool is_taken = false;
-  PCType target_pc = 0;
+  bool is_branch : 1 = false;
+  bool predicted_taken : 1 = false;
+  bool is_taken : 1 = false;
+  bool mispredicted : 1 = false;
+  bool is_return : 1 = false;
+  bool fused : 1 = false; // retires two instructions, the first at pc - 4
+  bool compressed : 1 = false;
 };
+static_assert(sizeof(ROBEntry) == 20, "ROBEntry grew; it is copied into the ROB and onto the commit bus");
 
 class ReorderBuffer {
   queue<ROBEntry, ROB_SIZE> buffer;
   RobIDType next_id = 1;
 
-  std::vector<WritePort<ROBEntry>*> allocate_ports;
-  std::vector<WritePort<CDBResult>*> cdb_ports;
-  std::vector<WritePort<BranchResult>*> branch_ports;
-  std::vector<WritePort<bool>*> pop_ports;
-
-public:
-  ReorderBuffer() {
-    Clock::getInstance().subscribe([this] { this->update_state(); }, FALLING);
-  }
-
-  ReadPort<RobIDType, std::optional<RegDataType>> create_get_port() {
-    return ReadPort<RobIDType, std::optional<RegDataType>>(
-        [this](RobIDType id) { return this->get(id); });
-  }
-
-
-  ReadPort<bool, RobIDType> create_next_id_port() {
-    return ReadPort<bool, RobIDType>(
-        [this](bool) { return this->next_id; });
-  }
-
-  ReadPort<bool, bool> create_stall_port() {
-      return ReadPort<bool, bool>(
-          [this](bool) { return this->buffer.full(); }
-      );
-  }
+  // Write ports are owned here; std::deque keeps the handed-out references stable.
+  std::deque<WritePort<ROBEntry>> allocate_ports;
+  std::deque<WritePort<CDBResult>> cdb_ports;
+  std::deque<WritePort<BranchResult>> branch_ports;
+  std::deque<WritePort<bool>> pop_ports;
 
-  ReadPort<bool, std::optional<ROBEntry>> create_front_port() {
-    return ReadPort<bool, std::optional<ROBEntry>>(
-        [this](bool) -> std::optional<ROBEntry> {
-          if (!buffer.empty())
-            return this->front();
-          return std::nullopt;
-        });
+  // Read port logic, declared ahead of the port aliases that name it.
+  std::optional<RegDataType> get(RobIDType id) {
+    if (ROBEntry* e = find(id); e && e->state == COMMIT_READY) {
+      return e->value;
+    }
+    return std::nullopt;
   }
-
-  WritePort<ROBEntry>& create_allocate_port() {
-    auto* port = new WritePort<ROBEntry>();
-    allocate_ports.push_back(port);
-    return *port;
+  RobIDType read_next_id(bool) { return next_id; }
+  bool read_full(bool) { return buffer.full(); }
+  std::optional<ROBEntry> read_front(bool) {
+    if (!buffer.empty())
+      return front();
+    return std::nullopt;
   }
 
-  WritePort<CDBResult>& create_cdb_port() {
-    auto* port = new WritePort<CDBResult>();
-    cdb_ports.push_back(port);
-    return *port;
-  }
+public:
+  using GetPort = ReadPort<&ReorderBuffer::get>;
+  using NextIdPort = ReadPort<&ReorderBuffer::read_next_id>;
+  using StallPort = ReadPort<&ReorderBuffer::read_full>;
+  using FrontPort = ReadPort<&ReorderBuffer::read_front>;
 
-  WritePort<BranchResult>& create_branch_port() {
-    auto* port = new WritePort<BranchResult>();
-    branch_ports.push_back(port);
-    return *port;
+  ReorderBuffer() {
+    Clock::getInstance().subscribe([this] { this->update_state(); }, FALLING);
   }
 
-  WritePort<bool>& create_pop_port() {
-    auto* port = new WritePort<bool>();
-    pop_ports.push_back(port);
-    return *port;
-  }
+  GetPort create_get_port() { return GetPort(*this); }
+  NextIdPort create_next_id_port() { return NextIdPort(*this); }
+  StallPort create_stall_port() { return StallPort(*this); }
+  FrontPort create_front_port() { return FrontPort(*this); }
 
+  WritePort<ROBEntry>& create_allocate_port() { return allocate_ports.emplace_back(); }
+  WritePort<CDBResult>& create_cdb_port() { return cdb_ports.emplace_back(); }
+  WritePort<BranchResult>& create_branch_port() { return branch_ports.emplace_back(); }
+  WritePort<bool>& create_pop_port() { return pop_ports.emplace_back(); }
 
   void update_state() {
-    for (auto* port : cdb_ports) {
-      if (auto result = port->consume()) {
+    for (auto& port : cdb_ports) {
+      if (auto result = port.consume()) {
         process_cdb(*result);
       }
     }
-    for (auto* port : branch_ports) {
-      if (auto result = port->consume()) {
+    for (auto& port : branch_ports) {
+      if (auto result = port.consume()) {
         process_branch(*result);
       }
     }
     // Process commit request
-    for (auto* port : pop_ports) {
-      if (port->consume()) {
+    for (auto& port : pop_ports) {
+      if (port.consume()) {
         pop_front();
       }
     }
     // Process new allocations last
-    for (auto* port : allocate_ports) {
-        if(auto entry = port->consume()) {
+    for (auto& port : allocate_ports) {
+        if(auto entry = port.consume()) {
             allocate(*entry);
         }
     }
@@ -123,65 +112,83 @@ public:
     next_id = 1;
   }
 
+  // only for debugging, e.g. the co-simulation divergence report
+  void dump(std::ostream& os) const {
+    static constexpr const char* state_names[] = {"ISSUED", "COMMIT_READY", "ISHALT"};
+    for (size_t i = 0; i < buffer.size(); i++) {
+      const ROBEntry& e = buffer[i];
+      os << "  [" << e.id << "] pc=0x" << std::hex << e.pc << std::dec << " " << e.type
+         << (e.fused ? " (fused)" : "")
+         << " rd=x" << static_cast<int>(e.reg_id) << " value=0x" << std::hex << e.value << std::dec
+         << " " << state_names[e.state];
+      if (e.is_branch) {
+        os << " pred=" << e.predicted_taken << " taken=" << e.is_taken
+           << " target=0x" << std::hex << e.target_pc << std::dec;
+      }
+      os << "\n";
+    }
+  }
+
 private:
-  const ROBEntry& front() const { return buffer.front(); }
+  const ROBEntry& front() const { return buffer.unchecked_front(); }
 
   void pop_front() {
     if (!buffer.empty()) {
-      logger.With("ROB_ID", buffer.front().id).Info("Popping committed entry from ROB.");
-      buffer.pop_front();
+      logger.With("ROB_ID", buffer.unchecked_front().id).Info("Popping committed entry from ROB.");
+      buffer.unchecked_pop_front();
     }
   }
 
   void allocate(ROBEntry e) {
-    if (buffer.full()) {
+    if (SIM_CHECKS && buffer.full()) {
         throw logger.Error("Attempted to allocate into a full ROB. This should be prevented by stall logic.");
     }
     e.id = next_id++;
     if (next_id == 0) next_id = 1;
-    buffer.push_back(e);
+    buffer.unchecked_push_back(e);
     logger.With("PC", e.pc).With("ROB_ID", e.id).Info("Instruction allocated in ROB.");
   }
 
-  std::optional<RegDataType> get(RobIDType id) {
-    for (int i = 0; i < buffer.size(); i++) {
-      if (buffer[i].id == id) {
-        if (buffer[i].state == COMMIT_READY) {
-          return buffer[i].value;
-        }
-        return std::nullopt;
-      }
+  // IDs are handed out consecutively (skipping 0 on wrap-around), so an entry sits
+  // at its distance from the front. The id comparison rejects stale or flushed ids.
+  ROBEntry* find(RobIDType id) {
+    if (id == 0 || buffer.empty()) {
+      return nullptr;
     }
-    return std::nullopt;
+    const RobIDType front_id = buffer.unchecked_front().id;
+    RobIDType offset = id - front_id;
+    if (id < front_id) {
+      --offset;
+    }
+    if (offset >= buffer.size() || buffer[offset].id != id) {
+      return nullptr;
+    }
+    return &buffer[offset];
   }
 
   void process_cdb(CDBResult result) {
-    for (int i = 0; i < buffer.size(); i++) {
-      if (buffer[i].id == result.rob_id) {
-        buffer[i].value = result.data;
-        buffer[i].state = COMMIT_READY;
-        logger.With("ROB_ID", buffer[i].id)
-            .With("Value", buffer[i].value)
-            .Info("ROB entry updated from CDB, ready to commit.");
-        return;
-      }
+    if (ROBEntry* e = find(result.rob_id)) {
+      e->value = result.data;
+      e->state = COMMIT_READY;
+      logger.With("ROB_ID", e->id)
+          .With("Value", e->value)
+          .Info("ROB entry updated from CDB, ready to commit.");
     }
   }
 
   void process_branch(BranchResult result) {
-    for (int i = 0; i < buffer.size(); i++) {
-      if (buffer[i].id == result.rob_id) {
-        buffer[i].is_taken = result.is_taken;
-        buffer[i].target_pc = result.target_pc;
-        if (buffer[i].reg_id == 0) {
-          buffer[i].state = COMMIT_READY;
-        }
-        logger.With("ROB_ID", buffer[i].id)
-            .With("Taken", buffer[i].is_taken)
-            .With("TargetPC", buffer[i].target_pc)
-            .Info("ROB branch entry updated.");
-        return;
+    if (ROBEntry* e = find(result.rob_id)) {
+      const PCType actual_next_pc = result.is_taken ? result.target_pc : fallthrough_pc(e->pc, e->compressed);
+      e->mispredicted = actual_next_pc != e->target_pc;
+      e->is_taken = result.is_taken;
+      e->target_pc = result.target_pc;
+      if (e->reg_id == 0) {
+        e->state = COMMIT_READY;
       }
+      logger.With("ROB_ID", e->id)
+          .With("Taken", e->is_taken)
+          .With("TargetPC", e->target_pc)
+          .Info("ROB branch entry updated.");
     }
   }
 };
\ No newline at end of file
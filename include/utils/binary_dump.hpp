@@ -0,0 +1,44 @@
+#pragma once
+
+// Binary layout of commit dumps, shared by the simulator's RegisterDumper
+// (utils/reg_dump.hpp), the reference interpreter (standard/dump.hpp) and dumpdiff.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace norb {
+
+    // Dumps whose file name ends in ".bin" use a fixed-size binary layout instead of text:
+    // the 8-byte magic below, a uint32 register count, then one record per commit holding
+    // the uint32 PC followed by one uint32 per register (all little-endian).
+    inline constexpr char BINARY_DUMP_MAGIC[8] = {'R', 'V', 'D', 'U', 'M', 'P', '0', '1'};
+    inline constexpr size_t BINARY_DUMP_HEADER_SIZE = sizeof(BINARY_DUMP_MAGIC) + sizeof(uint32_t);
+
+    // One commit: the PC, then the registers.
+    template <size_t reg_count_>
+    using BinaryDumpRecord = std::array<uint32_t, reg_count_ + 1>;
+
+    inline bool is_binary_dump_name(const std::string &filename) {
+        return filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".bin") == 0;
+    }
+
+    inline void write_binary_dump_header(std::ostream &out, uint32_t reg_count) {
+        out.write(BINARY_DUMP_MAGIC, sizeof(BINARY_DUMP_MAGIC));
+        out.write(reinterpret_cast<const char *>(&reg_count), sizeof(reg_count));
+    }
+
+    template <size_t reg_count_, typename RegType_>
+    void write_binary_dump_record(std::ostream &out, uint32_t pc_at_commit,
+                                  const std::array<RegType_, reg_count_> &reg_snapshot) {
+        BinaryDumpRecord<reg_count_> record;
+        record[0] = pc_at_commit;
+        for (size_t i = 0; i < reg_count_; ++i) {
+            record[i + 1] = static_cast<uint32_t>(reg_snapshot[i]);
+        }
+        out.write(reinterpret_cast<const char *>(record.data()), sizeof(record));
+    }
+
+}  // namespace norb
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "constants.hpp"
+#include "instruction.hpp"
+#include "middlend/rob.hpp"
+#include "utils/bus.hpp"
+#include "utils/clock.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Binary trace of committed control flow, read back by tools/bpreplay.
+ *
+ * Layout: the 8-byte magic below, then one 12-byte record per committed branch or jump
+ * (three little-endian uint32: PC, target, and `flags | instructions << 8`, where
+ * `instructions` counts the commits since the previous record including this one). A
+ * final record with BT_END set carries the instructions committed after the last branch.
+ */
+inline constexpr char BRANCH_TRACE_MAGIC[8] = {'B', 'R', 'T', 'R', 'A', 'C', 'E', '1'};
+
+enum BranchTraceFlags : uint8_t {
+  BT_TAKEN = 1 << 0,
+  BT_CONDITIONAL = 1 << 1,
+  BT_INDIRECT = 1 << 2, // JALR
+  BT_CALL = 1 << 3,
+  BT_RETURN = 1 << 4,
+  BT_END = 1 << 7,
+};
+
+struct BranchRecord {
+  PCType pc;
+  PCType target;
+  uint32_t flags_and_count;
+
+  uint8_t flags() const { return static_cast<uint8_t>(flags_and_count); }
+  uint32_t instructions() const { return flags_and_count >> 8; }
+  bool taken() const { return flags() & BT_TAKEN; }
+};
+static_assert(sizeof(BranchRecord) == 12);
+
+/**
+ * @class BranchTraceWriter
+ * @brief Watches the commit bus and appends every committed branch to a trace file.
+ */
+class BranchTraceWriter {
+  static constexpr uint32_t MAX_COUNT = (1u << 24) - 1;
+
+  Bus<ROBEntry>& commit_bus;
+  std::ofstream file;
+  uint32_t since_last = 0;
+
+  void write(PCType pc, PCType target, uint8_t flags) {
+    const BranchRecord record{pc, target, flags | since_last << 8};
+    file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    since_last = 0;
+  }
+
+public:
+  BranchTraceWriter(Bus<ROBEntry>& commit_bus, const std::string& path)
+      : commit_bus(commit_bus), file(path, std::ios::binary | std::ios::trunc) {
+    if (!file) {
+      throw std::runtime_error("cannot open branch trace " + path);
+    }
+    file.write(BRANCH_TRACE_MAGIC, sizeof(BRANCH_TRACE_MAGIC));
+    Clock::getInstance().subscribe([this] { this->work(); });
+  }
+
+  ~BranchTraceWriter() { write(0, 0, BT_END); }
+
+  void work() {
+    auto e = commit_bus.get();
+    if (!e) {
+      return;
+    }
+    since_last = std::min(since_last + (e->fused ? 2 : 1), MAX_COUNT);
+    if (!e->is_branch) {
+      return;
+    }
+    uint8_t flags = e->is_taken ? BT_TAKEN : 0;
+    if (is_conditional_branch(e->type)) flags |= BT_CONDITIONAL;
+    if (e->type == OpType::JALR) flags |= BT_INDIRECT;
+    if (is_call(e->type, e->reg_id)) flags |= BT_CALL;
+    if (e->is_return) flags |= BT_RETURN;
+    write(e->pc, e->target_pc, flags);
+  }
+};
+
+// Loads a whole trace; throws on a missing file or a bad magic.
+inline std::vector<BranchRecord> read_branch_trace(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  char magic[sizeof(BRANCH_TRACE_MAGIC)];
+  if (!file.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, BRANCH_TRACE_MAGIC, sizeof(magic)) != 0) {
+    throw std::runtime_error(path + " is not a branch trace");
+  }
+  std::vector<BranchRecord> records;
+  BranchRecord record;
+  while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+    records.push_back(record);
+  }
+  return records;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct Bundle
+ * @brief Up to N items that move through a pipeline stage together in one cycle.
+ *
+ * A fixed-capacity array with a count, so a wide stage sends one Channel payload per
+ * cycle instead of N. The capacity bounds the stage width.
+ */
+template <typename T, size_t N>
+struct Bundle {
+  static_assert(N <= UINT8_MAX, "bundle count is a uint8_t");
+
+  std::array<T, N> items{};
+  uint8_t count = 0;
+
+  static constexpr size_t capacity() { return N; }
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  bool full() const { return count == N; }
+
+  void push_back(const T& item) { items[count++] = item; }
+  void pop_back() { --count; }
+
+  const T& operator[](size_t i) const { return items[i]; }
+  T& operator[](size_t i) { return items[i]; }
+
+  const T* begin() const { return items.data(); }
+  const T* end() const { return items.data() + count; }
+};
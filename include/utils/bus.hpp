@@ -1,18 +1,26 @@
 #pragma once
 
 #include "utils/clock.hpp"
+#include "utils/queue.hpp"
+#include "utils/stats.hpp"
 #include <optional>
+#include <string>
+#include <utility>
 
 
 
 // this is a one consume reader(maybe multiple unconsumed), one-writer channel
+// The two slots are double-buffered: send() writes the writer slot in place and tick()
+// flips which slot the reader sees, so a payload is stored once and read in place.
 template<typename T>
 class Channel{
-    T reader_slot;
-    T writer_slot;
+    T slots[2]{};
+    unsigned char reader_index = 0;
     bool reader_ready = false;
     bool writer_ready = false;
     bool consumed = false;
+
+    T& writer_slot() { return slots[reader_index ^ 1]; }
 public:
     Channel(){
         Clock::getInstance().subscribe([this]() { this->tick();},FALLING);
@@ -24,18 +32,27 @@ public:
         if(writer_ready){
             return false;
         }
-        writer_slot = data;
+        writer_slot() = data;
+        writer_ready = true;
+        return true;
+    }
+    bool send(T&& data){
+        if(writer_ready){
+            return false;
+        }
+        writer_slot() = std::move(data);
         writer_ready = true;
         return true;
     }
-    std::optional<T> peek(){
-        if(!reader_ready) return std::nullopt;
-        return reader_slot;
+    // The returned pointer is null when nothing is pending and stays valid until the next tick.
+    const T* peek() const {
+        if(!reader_ready) return nullptr;
+        return &slots[reader_index];
     }
-    std::optional<T> receive(){
-        if(!reader_ready) return std::nullopt;
+    const T* receive(){
+        if(!reader_ready) return nullptr;
         consumed = true;
-        return reader_slot;
+        return &slots[reader_index];
     }
     void reader_clear(){
         reader_ready = false;
@@ -59,8 +76,82 @@ public:
         if(!reader_ready && writer_ready){
             reader_ready = true;
             writer_ready = false;
-            reader_slot = writer_slot;
+            reader_index ^= 1;
+        }
+    }
+};
+
+
+// A Channel with room for N latched entries, so the writer can run ahead of the reader.
+// Same interface and timing: a send() becomes visible after the next tick, and receive()
+// hands out the oldest entry, which is popped at the tick. One send and one receive per
+// cycle. Each tick adds the occupancy to `<name>.occupancy` (divide by cycles for the
+// mean) and counts `<name>.full_cycles`.
+template<typename T, size_t N>
+class QueueChannel{
+    queue<T, N> entries;
+    T pending{};
+    bool writer_ready = false;
+    bool consumed = false;
+
+    uint64_t& occupancy;
+    uint64_t& full_cycles;
+public:
+    explicit QueueChannel(const std::string& name)
+        : occupancy(Stats::getInstance().counter(name + ".occupancy")),
+          full_cycles(Stats::getInstance().counter(name + ".full_cycles")) {
+        Clock::getInstance().subscribe([this]() { this->tick();},FALLING);
+    }
+    // A slot freed by this cycle's receive() only counts after the tick.
+    bool can_send() const {
+        return !writer_ready && !entries.full();
+    }
+    bool send(const T& data){
+        if(!can_send()){
+            return false;
+        }
+        pending = data;
+        writer_ready = true;
+        return true;
+    }
+    const T* peek() const {
+        if(entries.empty()) return nullptr;
+        return &entries.unchecked_front();
+    }
+    const T* receive(){
+        if(entries.empty()) return nullptr;
+        consumed = true;
+        return &entries.unchecked_front();
+    }
+    size_t size() const {
+        return entries.size();
+    }
+    // The i-th oldest visible entry, for readers that look ahead of the front.
+    const T& operator[](size_t i) const {
+        return entries[i];
+    }
+    void reader_clear(){
+        entries.clear();
+        consumed = false;
+    }
+    void writer_clear(){
+        writer_ready = false;
+    }
+    void clear() {
+        reader_clear();
+        writer_clear();
+    }
+    void tick(){
+        if(consumed){
+            entries.unchecked_pop_front();
+            consumed = false;
+        }
+        if(writer_ready){
+            entries.unchecked_push_back(pending);
+            writer_ready = false;
         }
+        occupancy += entries.size();
+        full_cycles += entries.full();
     }
 };
 
@@ -116,7 +207,7 @@ public:
     bool send(const T& data){
         return channel.send(data);
     }
-    std::optional<T> get(){
+    const T* get() const {
         return channel.peek();
     }
 };
\ No newline at end of file
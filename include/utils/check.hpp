@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdexcept>
+
+/**
+ * Structural-hazard and invariant checks (a port read twice in one cycle, a push into a
+ * full queue, ...). They are on in the default "verify" flavor and compile to nothing
+ * when SIM_PRODUCTION is defined, which the "production" CMake flavor does.
+ *
+ * Errors that depend on the simulated program, such as an out-of-bounds memory access,
+ * are not checks and stay on in every flavor.
+ */
+#ifdef SIM_PRODUCTION
+inline constexpr bool SIM_CHECKS = false;
+#define SIM_CHECK(cond, message) ((void)0)
+#else
+inline constexpr bool SIM_CHECKS = true;
+#define SIM_CHECK(cond, message)                \
+    do {                                        \
+        if (!(cond)) [[unlikely]] {             \
+            throw std::runtime_error(message);  \
+        }                                       \
+    } while (0)
+#endif
@@ -48,7 +48,7 @@ public:
         }
     }
 
-    size_t getTime(){
+    size_t getTime() const {
         return current_time;
     }
 };
\ No newline at end of file
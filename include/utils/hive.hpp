@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <bit>
+#include <cstdint>
 #include <optional>
 #include <iterator> // For std::forward_iterator_tag
 #include <type_traits> // For std::conditional_t
@@ -8,14 +10,44 @@
 template<typename T, size_t MAX_SIZE>
 class hive {
 private:
-    // Each element is a pair of (is_active, value)
-    // Using std::optional would also work, but this is more memory-efficient
-    // as it avoids std::optional's overhead if T is large.
-    std::array<std::pair<bool, T>, MAX_SIZE> elements;
+    static constexpr size_t WORD_BITS = 64;
+    static constexpr size_t WORDS = (MAX_SIZE + WORD_BITS - 1) / WORD_BITS;
+
+    // Occupancy is kept apart from the values, one bit per slot, so that walking the
+    // active slots and finding a free one are a few countr_zero calls per 64 slots.
+    std::array<uint64_t, WORDS> occupied{};
+    std::array<T, MAX_SIZE> values{};
     size_t current_size = 0;
 
-    // A hint to speed up finding the next free slot for insertion.
-    size_t next_free_slot_hint = 0;
+    bool is_active(size_t index) const noexcept {
+        return (occupied[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+    }
+
+    // Index of the first active slot at or after `index`, or MAX_SIZE if there is none.
+    size_t next_active(size_t index) const noexcept {
+        size_t w = index / WORD_BITS;
+        if (w >= WORDS) {
+            return MAX_SIZE;
+        }
+        uint64_t bits = occupied[w] & (~uint64_t{0} << (index % WORD_BITS));
+        while (bits == 0) {
+            if (++w == WORDS) {
+                return MAX_SIZE;
+            }
+            bits = occupied[w];
+        }
+        return w * WORD_BITS + std::countr_zero(bits);
+    }
+
+    // Index of the lowest free slot, or a value >= MAX_SIZE if the hive is full.
+    size_t first_free() const noexcept {
+        for (size_t w = 0; w < WORDS; ++w) {
+            if (uint64_t free_bits = ~occupied[w]) {
+                return w * WORD_BITS + std::countr_zero(free_bits);
+            }
+        }
+        return MAX_SIZE;
+    }
 
 public:
     // --- Standard Container Typedefs ---
@@ -25,6 +57,7 @@ public:
     using pointer = T*;
     using const_pointer = const T*;
     using size_type = size_t;
+    using mask_type = std::array<uint64_t, WORDS>;
 
     // --- Iterator Class ---
     template<bool IsConst>
@@ -40,9 +73,7 @@ public:
 
         // Helper to find the next valid (active) element
         void find_next_valid() {
-            while (index < MAX_SIZE && !parent_hive->elements[index].first) {
-                ++index;
-            }
+            index = parent_hive->next_active(index);
         }
 
     public:
@@ -61,17 +92,22 @@ public:
             }
         }
 
+        // Slot of the element, stable for as long as it stays in the hive
+        size_type slot() const {
+            return index;
+        }
+
         // Allow conversion from non-const to const iterator
         operator base_iterator<true>() const {
             return base_iterator<true>(parent_hive, index);
         }
 
         reference operator*() const {
-            return parent_hive->elements[index].second;
+            return parent_hive->values[index];
         }
 
         pointer operator->() const {
-            return &parent_hive->elements[index].second;
+            return &parent_hive->values[index];
         }
 
         // Pre-increment
@@ -143,25 +179,14 @@ public:
      */
     template<typename U>
     std::optional<iterator> insert(U&& value) {
-        if (full()) {
+        size_t index = first_free();
+        if (index >= MAX_SIZE) {
             return std::nullopt;
         }
-
-        // Search for a free slot, starting from our hint
-        for (size_t i = 0; i < MAX_SIZE; ++i) {
-            size_t current_index = (next_free_slot_hint + i) % MAX_SIZE;
-            if (!elements[current_index].first) {
-                elements[current_index].first = true;
-                elements[current_index].second = std::forward<U>(value);
-                current_size++;
-                // Update the hint for the next insertion
-                next_free_slot_hint = current_index + 1;
-                return iterator(this, current_index);
-            }
-        }
-        
-        // Should be unreachable if full() check is correct, but good for safety
-        return std::nullopt; 
+        occupied[index / WORD_BITS] |= uint64_t{1} << (index % WORD_BITS);
+        values[index] = std::forward<U>(value);
+        current_size++;
+        return iterator(this, index);
     }
 
     /**
@@ -170,21 +195,40 @@ public:
      * @return An iterator to the element that followed the erased element.
      */
     iterator erase(iterator pos) {
-        if (pos.parent_hive != this || pos.index >= MAX_SIZE || !elements[pos.index].first) {
+        if (pos.parent_hive != this || pos.index >= MAX_SIZE || !is_active(pos.index)) {
             // Invalid iterator, return end()
             return end();
         }
 
-        elements[pos.index].first = false;
+        occupied[pos.index / WORD_BITS] &= ~(uint64_t{1} << (pos.index % WORD_BITS));
         current_size--;
-        
-        // This newly freed slot is a great candidate for the next insertion
-        next_free_slot_hint = pos.index;
 
         // Return an iterator to the next valid element
         return ++pos;
     }
 
+    // --- Slot Access ---
+    // For callers that keep per-slot side tables; `slot` must be active.
+    reference operator[](size_type slot) {
+        return values[slot];
+    }
+
+    const_reference operator[](size_type slot) const {
+        return values[slot];
+    }
+
+    void erase_slot(size_type slot) {
+        if (slot < MAX_SIZE && is_active(slot)) {
+            occupied[slot / WORD_BITS] &= ~(uint64_t{1} << (slot % WORD_BITS));
+            current_size--;
+        }
+    }
+
+    // One bit per slot, set while the slot holds an element
+    const mask_type& occupancy() const noexcept {
+        return occupied;
+    }
+
     // --- Capacity ---
     bool empty() const noexcept {
         return current_size == 0;
@@ -203,10 +247,7 @@ public:
     }
 
     void clear() noexcept {
-        for(size_t i = 0; i < MAX_SIZE; ++i) {
-            elements[i].first = false;
-        }
+        occupied.fill(0);
         current_size = 0;
-        next_free_slot_hint = 0;
     }
 };
\ No newline at end of file
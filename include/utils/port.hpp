@@ -1,9 +1,28 @@
 #pragma once
 
-#include "utils/clock.hpp" 
-#include <functional>
+#include "utils/check.hpp"
+#include "utils/clock.hpp"
+#include <cstddef>
 #include <stdexcept>
 
+/// @brief Splits a Holder's read member function `Output (Holder::*)(Input)` into its parts.
+template<typename Fn>
+struct read_port_traits;
+
+template<typename H, typename O, typename I>
+struct read_port_traits<O (H::*)(I)> {
+    using Holder = H;
+    using Output = O;
+    using Input = I;
+};
+
+template<typename H, typename O, typename I>
+struct read_port_traits<O (H::*)(I) const> {
+    using Holder = const H;
+    using Output = O;
+    using Input = I;
+};
+
 /**
  * @class ReadPort
  * @brief A generic, single-use, read-only port for synchronous data access.
@@ -11,53 +30,56 @@
  * @details This class models a physical read port on a hardware module (a "Holder").
  * It provides a synchronous, combinational "pull" interface for a "Worker" module.
  * The port is designed to be used exactly once per clock cycle, mimicking the physical
- * limitation of a single hardware read port. An internal flag, reset by the global
- * clock, enforces this rule at runtime.
+ * limitation of a single hardware read port. The port remembers the cycle of its last
+ * read and compares it with the global clock, which enforces this rule at runtime
+ * without a per-port clock callback.
  *
- * The core logic is provided via a `std::function` at construction, allowing this
- * generic port to be configured to perform any specific read action on its owning Holder.
+ * The read logic is a member function of the Holder, given as the template argument, so
+ * the call is direct and can be inlined. Holders declare an alias per port kind
+ * (e.g. `ReorderBuffer::GetPort`) and hand out ports through their create_*_port methods.
  *
- * @tparam Input The data type of the query or address sent to the port (e.g., an ID, an index).
- * @tparam Output The data type of the result returned by the port.
+ * @tparam Read Pointer to the Holder member function `Output (Holder::*)(Input)`.
  */
-template<typename Input, typename Output>
+template<auto Read>
 class ReadPort {
 private:
-    /// @brief The function object that encapsulates the actual read logic from the Holder.
-    std::function<Output(Input)> func;
+    using Traits = read_port_traits<decltype(Read)>;
+    using Holder = typename Traits::Holder;
+    using Input = typename Traits::Input;
+    using Output = typename Traits::Output;
+
+    Holder* holder;
+    const Clock* clock;
 
-    /// @brief A flag to enforce the single-use-per-cycle hardware limitation.
-    bool triggered = false;
+    /// @brief The cycle of the last read, used to enforce the single-use-per-cycle limitation.
+    size_t last_read = static_cast<size_t>(-1);
 
 public:
     /**
      * @brief Constructs a ReadPort.
-     * @param func A function (typically a lambda) that implements the read logic.
-     *             This function will be called when the port's `read()` method is invoked.
+     * @param holder The module whose state this port reads.
      */
-    ReadPort(std::function<Output(Input)> func) : func(func) {
-        // Subscribe to the global clock to automatically reset the port's state
-        // at the beginning of every cycle.
-        Clock::getInstance().subscribe([this] { this->triggered = false; });
-    }
+    explicit ReadPort(Holder& holder) : holder(&holder), clock(&Clock::getInstance()) {}
 
     /**
      * @brief Executes a read operation through the port.
      * @details This method should be called by a Worker on the RISING edge of the clock.
-     * It immediately executes the provided function and returns the result, modeling
+     * It immediately executes the Holder's read function and returns the result, modeling
      * a combinational read path.
      *
      * @param input The query or address for the read operation.
      * @return The result of the read operation.
      * @throws std::runtime_error if the port has already been used in the current clock cycle,
-     *         simulating a structural hazard where a single physical port is requested twice.
+     *         simulating a structural hazard where a single physical port is requested twice
+     *         (verify builds only, see utils/check.hpp).
      */
     Output read(Input input) {
-        if (triggered) {
-            throw std::runtime_error("ReadPort already triggered in this clock cycle");
+        if constexpr (SIM_CHECKS) {
+            size_t now = clock->getTime();
+            SIM_CHECK(last_read != now, "ReadPort already triggered in this clock cycle");
+            last_read = now;
         }
-        triggered = true;
-        return func(input);
+        return (holder->*Read)(input);
     }
 };
 #pragma once
@@ -110,12 +132,10 @@ public:
      *
      * @param data The data to be written.
      * @throws std::runtime_error if the buffer already contains data, indicating the
-     *         caller did not respect the `can_push()` check.
+     *         caller did not respect the `can_push()` check (verify builds only).
      */
     void push(DataType data) {
-        if (buffer.has_value()) {
-            throw std::runtime_error("WritePort buffer already contains data");
-        }
+        SIM_CHECK(!buffer.has_value(), "WritePort buffer already contains data");
         buffer = data;
     }
 
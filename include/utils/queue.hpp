@@ -1,5 +1,7 @@
 #pragma once
 
+#include "utils/check.hpp"
+
 #include <cstddef>
 #include <stdexcept>
 #include <type_traits>
@@ -14,12 +16,23 @@ private:
     size_t _back = 0;
     size_t _size = 0;
 
+    // Power-of-two capacities wrap with a mask instead of a division.
+    static constexpr bool POW2 = (MAX_SIZE & (MAX_SIZE - 1)) == 0;
+
+    static constexpr size_t wrap(size_t index) noexcept {
+        if constexpr (POW2) {
+            return index & (MAX_SIZE - 1);
+        } else {
+            return index % MAX_SIZE;
+        }
+    }
+
     static constexpr size_t next_index(size_t index) noexcept {
-        return (index + 1) % MAX_SIZE;
+        return wrap(index + 1);
     }
     
     static constexpr size_t prev_index(size_t index) noexcept {
-        return (index == 0) ? MAX_SIZE - 1 : index - 1;
+        return wrap(index + MAX_SIZE - 1);
     }
 
 public:
@@ -59,39 +72,62 @@ public:
     ~queue() = default;
 
     [[nodiscard]] reference front() {
-        if (empty()) {
-            throw std::runtime_error("Queue is empty");
-        }
+        SIM_CHECK(!empty(), "Queue is empty");
         return data[_front];
     }
     
     [[nodiscard]] const_reference front() const {
-        if (empty()) {
-            throw std::runtime_error("Queue is empty");
-        }
+        SIM_CHECK(!empty(), "Queue is empty");
         return data[_front];
     }
     
     [[nodiscard]] reference back() {
-        if (empty()) {
-            throw std::runtime_error("Queue is empty");
-        }
+        SIM_CHECK(!empty(), "Queue is empty");
         return data[prev_index(_back)];
     }
     
     [[nodiscard]] const_reference back() const {
-        if (empty()) {
-            throw std::runtime_error("Queue is empty");
-        }
+        SIM_CHECK(!empty(), "Queue is empty");
         return data[prev_index(_back)];
     }
 
+    // Unchecked access, for callers that have already tested empty()/full()
+    [[nodiscard]] reference unchecked_front() noexcept {
+        return data[_front];
+    }
+
+    [[nodiscard]] const_reference unchecked_front() const noexcept {
+        return data[_front];
+    }
+
+    [[nodiscard]] reference unchecked_back() noexcept {
+        return data[prev_index(_back)];
+    }
+
+    [[nodiscard]] const_reference unchecked_back() const noexcept {
+        return data[prev_index(_back)];
+    }
+
+    void unchecked_push_back(const T& value) {
+        data[_back] = value;
+        _back = next_index(_back);
+        ++_size;
+    }
+
+    void unchecked_pop_front() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            data[_front].~T();
+        }
+        _front = next_index(_front);
+        --_size;
+    }
+
     // Index access
     [[nodiscard]] reference at(size_type index) {
         if (index >= _size) {
             throw std::out_of_range("Queue index out of range");
         }
-        size_t real_index = (_front + index) % MAX_SIZE;
+        size_t real_index = wrap(_front + index);
         return data[real_index];
     }
     
@@ -99,17 +135,17 @@ public:
         if (index >= _size) {
             throw std::out_of_range("Queue index out of range");
         }
-        size_t real_index = (_front + index) % MAX_SIZE;
+        size_t real_index = wrap(_front + index);
         return data[real_index];
     }
     
     [[nodiscard]] reference operator[](size_type index) noexcept {
-        size_t real_index = (_front + index) % MAX_SIZE;
+        size_t real_index = wrap(_front + index);
         return data[real_index];
     }
     
     [[nodiscard]] const_reference operator[](size_type index) const noexcept {
-        size_t real_index = (_front + index) % MAX_SIZE;
+        size_t real_index = wrap(_front + index);
         return data[real_index];
     }
 
@@ -135,18 +171,14 @@ public:
     }
 
     void push_back(const T& value) {
-        if (full()) {
-            throw std::runtime_error("Queue is full");
-        }
+        SIM_CHECK(!full(), "Queue is full");
         data[_back] = value;
         _back = next_index(_back);
         ++_size;
     }
     
     void push_back(T&& value) {
-        if (full()) {
-            throw std::runtime_error("Queue is full");
-        }
+        SIM_CHECK(!full(), "Queue is full");
         data[_back] = std::move(value);
         _back = next_index(_back);
         ++_size;
@@ -154,18 +186,14 @@ public:
     
     template<typename... Args>
     void emplace_back(Args&&... args) {
-        if (full()) {
-            throw std::runtime_error("Queue is full");
-        }
+        SIM_CHECK(!full(), "Queue is full");
         data[_back] = T(std::forward<Args>(args)...);
         _back = next_index(_back);
         ++_size;
     }
     
     void pop_back() {
-        if (empty()) {
-            throw std::runtime_error("Queue is empty");
-        }
+        SIM_CHECK(!empty(), "Queue is empty");
         _back = prev_index(_back);
         --_size;
         if constexpr (!std::is_trivially_destructible_v<T>) {
@@ -174,18 +202,14 @@ public:
     }
 
     void push_front(const T& value) {
-        if (full()) {
-            throw std::runtime_error("Queue is full");
-        }
+        SIM_CHECK(!full(), "Queue is full");
         _front = prev_index(_front);
         data[_front] = value;
         ++_size;
     }
     
     void push_front(T&& value) {
-        if (full()) {
-            throw std::runtime_error("Queue is full");
-        }
+        SIM_CHECK(!full(), "Queue is full");
         _front = prev_index(_front);
         data[_front] = std::move(value);
         ++_size;
@@ -193,18 +217,14 @@ public:
     
     template<typename... Args>
     void emplace_front(Args&&... args) {
-        if (full()) {
-            throw std::runtime_error("Queue is full");
-        }
+        SIM_CHECK(!full(), "Queue is full");
         _front = prev_index(_front);
         data[_front] = T(std::forward<Args>(args)...);
         ++_size;
     }
     
     void pop_front() {
-        if (empty()) {
-            throw std::runtime_error("Queue is empty");
-        }
+        SIM_CHECK(!empty(), "Queue is empty");
         if constexpr (!std::is_trivially_destructible_v<T>) {
             data[_front].~T();
         }
@@ -224,6 +244,21 @@ public:
         }
     }
     
+    // Drops every element from position `count` on, keeping the oldest `count`.
+    void truncate(size_type count) noexcept {
+        if (count >= _size) {
+            return;
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            while (_size > count) {
+                pop_back();
+            }
+        } else {
+            _back = wrap(_front + count);
+            _size = count;
+        }
+    }
+
     void swap(queue& other) noexcept {
         if constexpr (std::is_trivially_copyable_v<T>) {
             std::swap(data, other.data);
@@ -8,6 +8,8 @@
 #include <cstdint>
 #include <string>
 
+#include "binary_dump.hpp"
+
 // The real implementation needs these headers.
 #ifdef ENABLE_REGISTER_DUMPER
 #include <fstream>
@@ -18,6 +20,8 @@
 
 namespace norb {
 
+    // Dumps whose file name ends in ".bin" use the binary layout of binary_dump.hpp.
+
 #ifdef ENABLE_REGISTER_DUMPER
 
     // --- REAL IMPLEMENTATION ---
@@ -29,14 +33,18 @@ namespace norb {
     private:
         std::ofstream file_;
         int line_number_;
+        bool binary_;
 
     public:
-        RegisterDumper(const std::string &filename) : line_number_(0) {
+        RegisterDumper(const std::string &filename) : line_number_(0), binary_(is_binary_dump_name(filename)) {
             // Clear the file at bootup and keep it open
-            file_.open(filename, std::ios::trunc);
+            file_.open(filename, binary_ ? std::ios::trunc | std::ios::binary : std::ios::trunc);
             if (!file_.is_open()) {
                 throw std::runtime_error("Failed to open file for register dumping: " + filename);
             }
+            if (binary_) {
+                write_binary_dump_header(file_, reg_count_);
+            }
         }
 
         ~RegisterDumper() {
@@ -46,7 +54,11 @@ namespace norb {
         }
 
         void dump(uint32_t pc_at_commit, const std::array<RegType_, reg_count_> reg_snapshot) {
-            dump_impl(pc_at_commit, reg_snapshot);
+            if (binary_) {
+                write_binary_dump_record(file_, pc_at_commit, reg_snapshot);
+            } else {
+                dump_impl(pc_at_commit, reg_snapshot);
+            }
         }
 
     private:
@@ -95,4 +107,4 @@ namespace norb {
 
 #endif // ENABLE_REGISTER_DUMPER
 
-}  // namespace norb
\ No newline at end of file
+}  // namespace norb
\ No newline at end of file
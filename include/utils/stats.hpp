@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+/**
+ * @class Stats
+ * @brief Registry of named event counters, summarized at the end of a run.
+ *
+ * Components look their counters up once at construction and keep the reference, so
+ * counting is a plain increment. Counters survive a CPU being rebuilt; reset() zeroes them.
+ */
+class Stats {
+  // std::map keeps element addresses stable, which the cached references rely on.
+  std::map<std::string, uint64_t> counters;
+
+public:
+  static Stats& getInstance() {
+    static Stats instance;
+    return instance;
+  }
+
+  uint64_t& counter(const std::string& name) { return counters[name]; }
+
+  void reset() {
+    for (auto& [name, value] : counters) {
+      value = 0;
+    }
+  }
+
+  void dump(std::ostream& os) const {
+    for (const auto& [name, value] : counters) {
+      os << name << " " << value << "\n";
+    }
+  }
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "constants.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @class TagArray
+ * @brief One ROB-id tag per reservation station slot, stored contiguously.
+ *
+ * match() compares every slot against a broadcast tag 32 bytes at a time (AVX2 when the
+ * build targets it, SSE2 otherwise on x86, scalar elsewhere) and returns one bit per
+ * slot, laid out like hive::occupancy() so the two can be ANDed together.
+ */
+template <size_t N>
+class TagArray {
+  static_assert(sizeof(RobIDType) == 2 || sizeof(RobIDType) == 4, "unsupported ROB id width");
+
+  // One 256-bit block of tags per compare step.
+  static constexpr size_t LANES = 32 / sizeof(RobIDType);
+  static constexpr size_t PADDED = (N + LANES - 1) / LANES * LANES;
+
+  alignas(32) std::array<RobIDType, PADDED> tags{};
+
+  static uint32_t match_block(const RobIDType* p, RobIDType tag) {
+#if defined(__AVX2__)
+    __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(p));
+    if constexpr (sizeof(RobIDType) == 4) {
+      __m256i eq = _mm256_cmpeq_epi32(v, _mm256_set1_epi32(static_cast<int>(tag)));
+      return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+    } else {
+      __m256i eq = _mm256_cmpeq_epi16(v, _mm256_set1_epi16(static_cast<short>(tag)));
+      __m128i packed = _mm_packs_epi16(_mm256_castsi256_si128(eq), _mm256_extracti128_si256(eq, 1));
+      return static_cast<uint32_t>(_mm_movemask_epi8(packed));
+    }
+#elif defined(__SSE2__)
+    __m128i lo = _mm_load_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hi = _mm_load_si128(reinterpret_cast<const __m128i*>(p) + 1);
+    if constexpr (sizeof(RobIDType) == 4) {
+      __m128i t = _mm_set1_epi32(static_cast<int>(tag));
+      return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lo, t)))) |
+             static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(hi, t)))) << 4;
+    } else {
+      __m128i t = _mm_set1_epi16(static_cast<short>(tag));
+      __m128i packed = _mm_packs_epi16(_mm_cmpeq_epi16(lo, t), _mm_cmpeq_epi16(hi, t));
+      return static_cast<uint32_t>(_mm_movemask_epi8(packed));
+    }
+#else
+    uint32_t bits = 0;
+    for (size_t i = 0; i < LANES; ++i) {
+      bits |= static_cast<uint32_t>(p[i] == tag) << i;
+    }
+    return bits;
+#endif
+  }
+
+public:
+  static constexpr size_t WORDS = (N + 63) / 64;
+  using Mask = std::array<uint64_t, WORDS>;
+
+  RobIDType get(size_t slot) const { return tags[slot]; }
+  void set(size_t slot, RobIDType tag) { tags[slot] = tag; }
+
+  // Bit i is set when slot i holds `tag`; bits of empty slots are meaningless.
+  Mask match(RobIDType tag) const {
+    Mask mask{};
+    for (size_t i = 0; i < PADDED; i += LANES) {
+      mask[i / 64] |= static_cast<uint64_t>(match_block(&tags[i], tag)) << (i % 64);
+    }
+    return mask;
+  }
+};
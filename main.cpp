@@ -3,8 +3,39 @@
 #include "loader.hpp"
 #include "logger.hpp"
 #include "utils/logger/logger.hpp"
+#include "utils/stats.hpp"
+#include <cstring>
+#include <fstream>
 
-int main() {
+int main(int argc, char** argv) {
+    // code [--stats] [--predictor NAME] [--branch-trace FILE] [--fusion] [image]: reads the
+    // memory image from stdin unless a file is given; --stats prints the event counters to
+    // stderr after the run; --predictor picks the branch direction predictor (bimodal,
+    // gshare, tage, perceptron); --branch-trace records committed branches for
+    // tools/bpreplay; --fusion turns on macro-op fusion in the decoder
+    bool print_stats = false;
+    PredictorKind predictor_kind = PredictorKind::TAGE_SC_L;
+    std::string branch_trace_path;
+    bool fusion = false;
+    const char* image_path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--stats") == 0) {
+            print_stats = true;
+        } else if (std::strcmp(argv[i], "--predictor") == 0 && i + 1 < argc) {
+            auto kind = parse_predictor_kind(argv[++i]);
+            if (!kind) {
+                std::cerr << "unknown predictor " << argv[i] << "\n";
+                return 2;
+            }
+            predictor_kind = *kind;
+        } else if (std::strcmp(argv[i], "--branch-trace") == 0 && i + 1 < argc) {
+            branch_trace_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--fusion") == 0) {
+            fusion = true;
+        } else {
+            image_path = argv[i];
+        }
+    }
     //std::ofstream log_file("cpu_sim.log");
     //logger.SetStream(log_file);
     logger.SetStream(std::cerr);
@@ -13,12 +44,22 @@ int main() {
     //std::ifstream data_file("../data/testcases/qsort.data");
     try {
         //auto initial_memory_image = Loader::parse_memory_image(data_file);
-        auto initial_memory_image = Loader::parse_memory_image(std::cin);
-        CPU cpu(initial_memory_image);
+        std::ifstream image_file;
+        if (image_path) {
+            image_file.open(image_path);
+            if (!image_file) {
+                throw std::runtime_error(std::string("cannot open ") + image_path);
+            }
+        }
+        auto initial_memory_image = Loader::parse_memory_image(image_path ? image_file : std::cin);
+        CPU cpu(initial_memory_image, predictor_kind, branch_trace_path, fusion);
 
-        Clock& clock = Clock::getInstance();
-        while (true) {
-            clock.tick();
+        RegDataType a0_value = cpu.run();
+        std::cout << (a0_value & 0xff) << std::endl;
+        if (print_stats) {
+            std::cerr << "cycles " << Clock::getInstance().getTime() << "\n"
+                      << "committed " << cpu.committed_count() << "\n";
+            Stats::getInstance().dump(std::cerr);
         }
     } catch (const std::exception& e) {
         std::cerr << "Critical error during setup or execution: " << e.what() << std::endl;
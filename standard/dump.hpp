@@ -8,6 +8,8 @@
 #include <string>
 #include <stdexcept>
 
+#include "../include/utils/binary_dump.hpp"
+
 namespace norb {
 
     // Helper function to format a number as a hex string
@@ -31,13 +33,18 @@ namespace norb {
     private:
         std::ofstream file_;
         int line_number_;
+        bool binary_;
 
     public:
-        RegisterDumper(const std::string &filename) : line_number_(0) {
-            file_.open(filename, std::ios::trunc);
+        // A ".bin" file name selects the binary layout of include/utils/binary_dump.hpp.
+        RegisterDumper(const std::string &filename) : line_number_(0), binary_(is_binary_dump_name(filename)) {
+            file_.open(filename, binary_ ? std::ios::trunc | std::ios::binary : std::ios::trunc);
             if (!file_.is_open()) {
                 throw std::runtime_error("Failed to open file for register dumping: " + filename);
             }
+            if (binary_) {
+                write_binary_dump_header(file_, reg_count_);
+            }
         }
 
         ~RegisterDumper() {
@@ -47,6 +54,10 @@ namespace norb {
         }
 
         void dump(uint32_t pc_at_commit, const std::array<RegType_, reg_count_> reg_snapshot) {
+            if (binary_) {
+                write_binary_dump_record(file_, pc_at_commit, reg_snapshot);
+                return;
+            }
             dump_impl(pc_at_commit, reg_snapshot);
         }
 
@@ -74,4 +85,4 @@ namespace norb {
             file_.flush();
         }
     };
-}  // namespace norb
\ No newline at end of file
+}  // namespace norb
\ No newline at end of file
@@ -0,0 +1,332 @@
+// dumpdiff: find the first mismatching commit record between two register dumps.
+//
+// Usage: dumpdiff [-C context] <expected dump> <actual dump>
+//
+// Both files are memory-mapped and compared in 64-byte blocks with AVX2 (or SSE2 when
+// AVX2 is unavailable at run time), so multi-gigabyte dumps are scanned at memory
+// bandwidth without buffering them. Text dumps (norb::RegisterDumper format) and
+// binary dumps (".bin", see include/utils/binary_dump.hpp) are detected automatically.
+//
+// Exit status: 0 if the dumps are identical, 1 if they differ, 2 on error.
+
+#include "utils/dump.hpp"
+#include "utils/reg_dump.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DUMPDIFF_X86 1
+#endif
+
+namespace {
+
+class MappedFile {
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+
+public:
+    explicit MappedFile(const char* path) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error(std::string("cannot open ") + path);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error(std::string("cannot stat ") + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error(std::string("cannot mmap ") + path);
+            }
+            ::madvise(p, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(p);
+        }
+        ::close(fd);
+    }
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    std::string_view view() const { return {data_, size_}; }
+};
+
+// --- First-mismatch search ---
+
+size_t mismatch_scalar(const char* a, const char* b, size_t i, size_t n) {
+    while (i < n && a[i] == b[i]) {
+        ++i;
+    }
+    return i;
+}
+
+#ifdef DUMPDIFF_X86
+__attribute__((target("avx2"))) size_t mismatch_avx2(const char* a, const char* b, size_t n) {
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        __m256i a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 32));
+        __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 32));
+        uint32_t eq0 = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a0, b0)));
+        uint32_t eq1 = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a1, b1)));
+        uint64_t ne = ~((static_cast<uint64_t>(eq1) << 32) | eq0);
+        if (ne != 0) {
+            return i + static_cast<size_t>(__builtin_ctzll(ne));
+        }
+    }
+    return mismatch_scalar(a, b, i, n);
+}
+
+size_t mismatch_sse2(const char* a, const char* b, size_t n) {
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        uint64_t eq = 0;
+        for (int k = 0; k < 4; ++k) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 16 * k));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 16 * k));
+            eq |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)))) << (16 * k);
+        }
+        if (~eq != 0) {
+            return i + static_cast<size_t>(__builtin_ctzll(~eq));
+        }
+    }
+    return mismatch_scalar(a, b, i, n);
+}
+#endif
+
+// Returns the offset of the first differing byte within the common length.
+size_t first_mismatch(const char* a, const char* b, size_t n) {
+#ifdef DUMPDIFF_X86
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2 ? mismatch_avx2(a, b, n) : mismatch_sse2(a, b, n);
+#else
+    return mismatch_scalar(a, b, 0, n);
+#endif
+}
+
+// --- Record model shared by both formats ---
+
+struct Record {
+    bool valid = false;
+    uint32_t pc = 0;
+    std::vector<uint32_t> regs;
+};
+
+void print_reg_diff(const Record& expected, const Record& actual) {
+    if (!expected.valid || !actual.valid) {
+        std::printf("  (record missing on one side)\n");
+        return;
+    }
+    if (expected.pc != actual.pc) {
+        std::printf("  pc:  expected %s, got %s\n", norb::hex(expected.pc).c_str(), norb::hex(actual.pc).c_str());
+    }
+    size_t n = std::max(expected.regs.size(), actual.regs.size());
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t e = i < expected.regs.size() ? expected.regs[i] : 0;
+        uint32_t g = i < actual.regs.size() ? actual.regs[i] : 0;
+        if (e != g) {
+            std::printf("  x%-2zu: expected %s, got %s\n", i, norb::hex(e).c_str(), norb::hex(g).c_str());
+        }
+    }
+}
+
+// --- Text dumps: "[0001] 0x00000000 | R0(0) R1(5=0x00000005) ..." ---
+
+size_t line_start(std::string_view s, size_t pos) {
+    while (pos > 0 && s[pos - 1] != '\n') {
+        --pos;
+    }
+    return pos;
+}
+
+std::string_view line_at(std::string_view s, size_t start) {
+    size_t end = s.find('\n', start);
+    return s.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+}
+
+Record parse_text_record(std::string_view line) {
+    Record rec;
+    size_t bar = line.find(" | ");
+    size_t hex = line.find("0x");
+    if (bar == std::string_view::npos || hex == std::string_view::npos || hex > bar) {
+        return rec;
+    }
+    rec.pc = static_cast<uint32_t>(std::strtoul(std::string(line.substr(hex, bar - hex)).c_str(), nullptr, 16));
+    size_t pos = bar + 3;
+    while ((pos = line.find('R', pos)) != std::string_view::npos) {
+        size_t open = line.find('(', pos);
+        size_t close = line.find(')', open);
+        if (open == std::string_view::npos || close == std::string_view::npos) {
+            break;
+        }
+        std::string value(line.substr(open + 1, close - open - 1));
+        rec.regs.push_back(static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10)));
+        pos = close + 1;
+    }
+    rec.valid = true;
+    return rec;
+}
+
+void print_text_context(const char* label, std::string_view s, size_t start, int context) {
+    std::printf("--- %s ---\n", label);
+    size_t first = start;
+    int before = 0;
+    while (before < context && first > 0) {
+        first = line_start(s, first - 1);
+        ++before;
+    }
+    size_t pos = first;
+    for (int k = 0; k <= before + context && pos < s.size(); ++k) {
+        std::string_view line = line_at(s, pos);
+        std::printf("%s %.*s\n", pos == start ? ">" : " ", static_cast<int>(line.size()), line.data());
+        pos += line.size() + 1;
+    }
+}
+
+int diff_text(const MappedFile& expected, const MappedFile& actual, int context) {
+    std::string_view a = expected.view();
+    std::string_view b = actual.view();
+    size_t common = std::min(a.size(), b.size());
+    size_t off = first_mismatch(a.data(), b.data(), common);
+    if (off == common && a.size() == b.size()) {
+        std::printf("dumps are identical (%zu bytes)\n", a.size());
+        return 0;
+    }
+    size_t start = line_start(off < common ? a : (a.size() > b.size() ? a : b), off);
+    std::string_view la = start < a.size() ? line_at(a, start) : std::string_view{};
+    std::string_view lb = start < b.size() ? line_at(b, start) : std::string_view{};
+    std::string_view ref = la.empty() ? lb : la;
+    size_t idx_end = ref.find(']');
+    std::string index = (ref.size() > 1 && ref[0] == '[' && idx_end != std::string_view::npos)
+                            ? std::string(ref.substr(1, idx_end - 1))
+                            : std::string("?");
+
+    std::printf("first mismatch at record %s (byte offset %zu)\n", index.c_str(), off);
+    print_text_context("expected", a, start, context);
+    print_text_context("actual", b, start, context);
+    std::printf("--- differences ---\n");
+    print_reg_diff(la.empty() ? Record{} : parse_text_record(la), lb.empty() ? Record{} : parse_text_record(lb));
+    return 1;
+}
+
+// --- Binary dumps ---
+
+bool is_binary(const MappedFile& f) {
+    return f.size() >= norb::BINARY_DUMP_HEADER_SIZE &&
+           std::memcmp(f.data(), norb::BINARY_DUMP_MAGIC, sizeof(norb::BINARY_DUMP_MAGIC)) == 0;
+}
+
+uint32_t binary_reg_count(const MappedFile& f) {
+    uint32_t count;
+    std::memcpy(&count, f.data() + sizeof(norb::BINARY_DUMP_MAGIC), sizeof(count));
+    return count;
+}
+
+Record binary_record(const MappedFile& f, size_t index, uint32_t reg_count) {
+    Record rec;
+    size_t record_size = (reg_count + 1) * sizeof(uint32_t);
+    size_t off = norb::BINARY_DUMP_HEADER_SIZE + index * record_size;
+    if (off + record_size > f.size()) {
+        return rec;
+    }
+    std::vector<uint32_t> words(reg_count + 1);
+    std::memcpy(words.data(), f.data() + off, record_size);
+    rec.valid = true;
+    rec.pc = words[0];
+    rec.regs.assign(words.begin() + 1, words.end());
+    return rec;
+}
+
+void print_binary_record(size_t index, const Record& rec, bool marked) {
+    if (!rec.valid) {
+        return;
+    }
+    std::printf("%s [%04zu] %s |", marked ? ">" : " ", index + 1, norb::hex(rec.pc).c_str());
+    for (size_t i = 0; i < rec.regs.size(); ++i) {
+        if (rec.regs[i] != 0) {
+            std::printf(" R%zu(%s)", i, norb::hex(rec.regs[i]).c_str());
+        }
+    }
+    std::printf("\n");
+}
+
+int diff_binary(const MappedFile& expected, const MappedFile& actual, int context) {
+    uint32_t reg_count = binary_reg_count(expected);
+    if (binary_reg_count(actual) != reg_count) {
+        std::fprintf(stderr, "register counts differ: %u vs %u\n", reg_count, binary_reg_count(actual));
+        return 2;
+    }
+    size_t record_size = (reg_count + 1) * sizeof(uint32_t);
+    size_t common = std::min(expected.size(), actual.size());
+    size_t off = first_mismatch(expected.data(), actual.data(), common);
+    if (off == common && expected.size() == actual.size()) {
+        std::printf("dumps are identical (%zu records)\n", (expected.size() - norb::BINARY_DUMP_HEADER_SIZE) / record_size);
+        return 0;
+    }
+    size_t index = (off - norb::BINARY_DUMP_HEADER_SIZE) / record_size;
+    std::printf("first mismatch at record %zu (byte offset %zu)\n", index + 1, off);
+    size_t first = index > static_cast<size_t>(context) ? index - context : 0;
+    for (const auto* side : {&expected, &actual}) {
+        std::printf("--- %s ---\n", side == &expected ? "expected" : "actual");
+        for (size_t i = first; i <= index + context; ++i) {
+            print_binary_record(i, binary_record(*side, i, reg_count), i == index);
+        }
+    }
+    std::printf("--- differences ---\n");
+    print_reg_diff(binary_record(expected, index, reg_count), binary_record(actual, index, reg_count));
+    return 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int context = 3;
+    int arg = 1;
+    if (arg + 1 < argc && std::strcmp(argv[arg], "-C") == 0) {
+        context = std::atoi(argv[arg + 1]);
+        arg += 2;
+    }
+    if (argc - arg != 2) {
+        std::fprintf(stderr, "usage: %s [-C context] <expected dump> <actual dump>\n", argv[0]);
+        return 2;
+    }
+    try {
+        MappedFile expected(argv[arg]);
+        MappedFile actual(argv[arg + 1]);
+        bool bin_a = is_binary(expected);
+        bool bin_b = is_binary(actual);
+        if (bin_a != bin_b) {
+            std::fprintf(stderr, "cannot compare a text dump with a binary dump\n");
+            return 2;
+        }
+        return bin_a ? diff_binary(expected, actual, context) : diff_text(expected, actual, context);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "dumpdiff: %s\n", e.what());
+        return 2;
+    }
+}
@@ -0,0 +1,433 @@
+#pragma once
+
+// A tiny RV32IC assembler for building test and benchmark programs in C++,
+// so workloads can be produced without a RISC-V cross toolchain.
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace rv32i {
+
+enum Reg : uint8_t {
+    zero = 0, ra, sp, gp, tp, t0, t1, t2,
+    s0, s1, a0, a1, a2, a3, a4, a5,
+    a6, a7, s2, s3, s4, s5, s6, s7,
+    s8, s9, s10, s11, t3, t4, t5, t6
+};
+
+/// The simulator stops when `addi a0, zero, 255` reaches the head of the ROB.
+constexpr uint32_t HALT_WORD = 0x0ff00513;
+
+inline uint32_t r_type(uint32_t funct7, Reg rs2, Reg rs1, uint32_t funct3, Reg rd, uint32_t opcode) {
+    return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+}
+
+inline uint32_t i_type(int32_t imm, Reg rs1, uint32_t funct3, Reg rd, uint32_t opcode) {
+    return ((static_cast<uint32_t>(imm) & 0xFFF) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+}
+
+inline uint32_t s_type(int32_t imm, Reg rs2, Reg rs1, uint32_t funct3) {
+    uint32_t u = static_cast<uint32_t>(imm);
+    return (((u >> 5) & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | ((u & 0x1F) << 7) | 0b0100011;
+}
+
+inline uint32_t b_type(int32_t offset, Reg rs2, Reg rs1, uint32_t funct3) {
+    uint32_t u = static_cast<uint32_t>(offset);
+    return (((u >> 12) & 1) << 31) | (((u >> 5) & 0x3F) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) |
+           (((u >> 1) & 0xF) << 8) | (((u >> 11) & 1) << 7) | 0b1100011;
+}
+
+inline uint32_t u_type(uint32_t imm20, Reg rd, uint32_t opcode) {
+    return ((imm20 & 0xFFFFF) << 12) | (rd << 7) | opcode;
+}
+
+inline uint32_t j_type(int32_t offset, Reg rd) {
+    uint32_t u = static_cast<uint32_t>(offset);
+    return (((u >> 20) & 1) << 31) | (((u >> 1) & 0x3FF) << 21) | (((u >> 11) & 1) << 20) |
+           (((u >> 12) & 0xFF) << 12) | (rd << 7) | 0b1101111;
+}
+
+// RV32C formats. `cb_type` and `cj_type` take byte offsets.
+inline uint32_t bit_range(uint32_t v, int hi, int lo) { return (v >> lo) & ((1u << (hi - lo + 1)) - 1); }
+
+inline uint16_t cb_type(int32_t offset, uint32_t rs1, uint32_t funct3) {
+    uint32_t u = static_cast<uint32_t>(offset);
+    return static_cast<uint16_t>((funct3 << 13) | (bit_range(u, 8, 8) << 12) | (bit_range(u, 4, 3) << 10) |
+                                 ((rs1 - 8) << 7) | (bit_range(u, 7, 6) << 5) | (bit_range(u, 2, 1) << 3) |
+                                 (bit_range(u, 5, 5) << 2) | 0b01);
+}
+
+inline uint16_t cj_type(int32_t offset, uint32_t funct3) {
+    uint32_t u = static_cast<uint32_t>(offset);
+    return static_cast<uint16_t>((funct3 << 13) | (bit_range(u, 11, 11) << 12) | (bit_range(u, 4, 4) << 11) |
+                                 (bit_range(u, 9, 8) << 9) | (bit_range(u, 10, 10) << 8) |
+                                 (bit_range(u, 6, 6) << 7) | (bit_range(u, 7, 7) << 6) |
+                                 (bit_range(u, 3, 1) << 3) | (bit_range(u, 5, 5) << 2) | 0b01);
+}
+
+inline uint16_t ci_type(uint32_t funct3, int32_t imm, uint32_t rd, uint32_t op) {
+    uint32_t u = static_cast<uint32_t>(imm);
+    return static_cast<uint16_t>((funct3 << 13) | (bit_range(u, 5, 5) << 12) | (rd << 7) |
+                                 (bit_range(u, 4, 0) << 2) | op);
+}
+
+inline uint16_t cr_type(uint32_t funct4, uint32_t rd, uint32_t rs2) {
+    return static_cast<uint16_t>((funct4 << 12) | (rd << 7) | (rs2 << 2) | 0b10);
+}
+
+inline bool fits_signed(int32_t v, int bits) { return v >= -(1 << (bits - 1)) && v < (1 << (bits - 1)); }
+inline bool is_creg(uint32_t r) { return r >= 8 && r <= 15; }
+
+/**
+ * @brief The 16-bit RV32C form of an RV32I word, if it has one.
+ * Covers the integer subset a compiler emits most: register moves and ALU ops on the
+ * same register, small immediates, stack and x8-x15 based word accesses, and register
+ * jumps. Branches and jumps to labels are never compressed here, since their offsets
+ * are not known yet (see Assembler::c_beqz and friends).
+ */
+inline std::optional<uint16_t> compress(uint32_t w) {
+    const uint32_t opcode = w & 0x7F;
+    const uint32_t rd = (w >> 7) & 0x1F;
+    const uint32_t funct3 = (w >> 12) & 0x7;
+    const uint32_t rs1 = (w >> 15) & 0x1F;
+    const uint32_t rs2 = (w >> 20) & 0x1F;
+    const uint32_t funct7 = w >> 25;
+    const int32_t imm_i = static_cast<int32_t>(w) >> 20;
+    const int32_t imm_s = (static_cast<int32_t>(w & 0xFE000000) >> 20) | static_cast<int32_t>(rd);
+
+    switch (opcode) {
+    case 0b0010011: // ALU immediate
+        switch (funct3) {
+        case 0b000: // ADDI
+            if (rd == 0 && rs1 == 0 && imm_i == 0) return 0x0001; // c.nop
+            if (rd == 0) break;
+            if (rs1 == 0 && fits_signed(imm_i, 6)) return ci_type(0b010, imm_i, rd, 0b01); // c.li
+            if (imm_i == 0 && rs1 != 0) return cr_type(0b1000, rd, rs1);                    // c.mv
+            if (rd == rs1 && rd == sp && imm_i % 16 == 0 && fits_signed(imm_i, 10)) {        // c.addi16sp
+                const uint32_t u = static_cast<uint32_t>(imm_i);
+                return static_cast<uint16_t>((0b011 << 13) | (bit_range(u, 9, 9) << 12) | (sp << 7) |
+                                             (bit_range(u, 4, 4) << 6) | (bit_range(u, 6, 6) << 5) |
+                                             (bit_range(u, 8, 7) << 3) | (bit_range(u, 5, 5) << 2) | 0b01);
+            }
+            if (rd == rs1 && fits_signed(imm_i, 6)) return ci_type(0b000, imm_i, rd, 0b01); // c.addi
+            if (rs1 == sp && is_creg(rd) && imm_i > 0 && imm_i < 1024 && imm_i % 4 == 0) {    // c.addi4spn
+                const uint32_t u = static_cast<uint32_t>(imm_i);
+                return static_cast<uint16_t>((bit_range(u, 5, 4) << 11) | (bit_range(u, 9, 6) << 7) |
+                                             (bit_range(u, 2, 2) << 6) | (bit_range(u, 3, 3) << 5) |
+                                             ((rd - 8) << 2));
+            }
+            break;
+        case 0b001: // SLLI
+            if (rd == rs1 && rd != 0 && rs2 != 0) return ci_type(0b000, static_cast<int32_t>(rs2), rd, 0b10);
+            break;
+        case 0b101: // SRLI, SRAI
+            if (rd == rs1 && is_creg(rd) && rs2 != 0) {
+                return static_cast<uint16_t>((0b100 << 13) | ((funct7 ? 0b01u : 0b00u) << 10) | ((rd - 8) << 7) |
+                                             (rs2 << 2) | 0b01);
+            }
+            break;
+        case 0b111: // ANDI
+            if (rd == rs1 && is_creg(rd) && fits_signed(imm_i, 6)) {
+                return static_cast<uint16_t>(ci_type(0b100, imm_i, rd - 8, 0b01) | (0b10 << 10));
+            }
+            break;
+        }
+        break;
+    case 0b0110011: { // ALU register
+        if (funct7 == 0 && funct3 == 0b000 && rd != 0 && rs2 != 0) { // ADD
+            if (rs1 == 0) return cr_type(0b1000, rd, rs2);  // c.mv
+            if (rd == rs1) return cr_type(0b1001, rd, rs2); // c.add
+            if (rd == rs2) return cr_type(0b1001, rd, rs1);
+            break;
+        }
+        uint32_t funct2;
+        bool commutes = true;
+        if (funct7 == 0x20 && funct3 == 0b000) {
+            funct2 = 0b00; // c.sub
+            commutes = false;
+        } else if (funct7 == 0 && funct3 == 0b100) {
+            funct2 = 0b01; // c.xor
+        } else if (funct7 == 0 && funct3 == 0b110) {
+            funct2 = 0b10; // c.or
+        } else if (funct7 == 0 && funct3 == 0b111) {
+            funct2 = 0b11; // c.and
+        } else {
+            break;
+        }
+        const uint32_t other = rd == rs1 ? rs2 : (commutes && rd == rs2 ? rs1 : 32);
+        if (is_creg(rd) && is_creg(other)) {
+            return static_cast<uint16_t>((0b100011 << 10) | ((rd - 8) << 7) | (funct2 << 5) | ((other - 8) << 2) |
+                                         0b01);
+        }
+        break;
+    }
+    case 0b0110111: { // LUI
+        const int32_t imm = static_cast<int32_t>(w) >> 12;
+        if (rd != 0 && rd != sp && imm != 0 && fits_signed(imm, 6)) return ci_type(0b011, imm, rd, 0b01);
+        break;
+    }
+    case 0b0000011: // LW
+        if (funct3 != 0b010 || imm_i < 0 || imm_i % 4 != 0) break;
+        if (rs1 == sp && rd != 0 && imm_i < 256) {
+            const uint32_t u = static_cast<uint32_t>(imm_i);
+            return static_cast<uint16_t>((0b010 << 13) | (bit_range(u, 5, 5) << 12) | (rd << 7) |
+                                         (bit_range(u, 4, 2) << 4) | (bit_range(u, 7, 6) << 2) | 0b10);
+        }
+        if (is_creg(rs1) && is_creg(rd) && imm_i < 128) {
+            const uint32_t u = static_cast<uint32_t>(imm_i);
+            return static_cast<uint16_t>((0b010 << 13) | (bit_range(u, 5, 3) << 10) | ((rs1 - 8) << 7) |
+                                         (bit_range(u, 2, 2) << 6) | (bit_range(u, 6, 6) << 5) | ((rd - 8) << 2));
+        }
+        break;
+    case 0b0100011: // SW
+        if (funct3 != 0b010 || imm_s < 0 || imm_s % 4 != 0) break;
+        if (rs1 == sp && imm_s < 256) {
+            const uint32_t u = static_cast<uint32_t>(imm_s);
+            return static_cast<uint16_t>((0b110 << 13) | (bit_range(u, 5, 2) << 9) | (bit_range(u, 7, 6) << 7) |
+                                         (rs2 << 2) | 0b10);
+        }
+        if (is_creg(rs1) && is_creg(rs2) && imm_s < 128) {
+            const uint32_t u = static_cast<uint32_t>(imm_s);
+            return static_cast<uint16_t>((0b110 << 13) | (bit_range(u, 5, 3) << 10) | ((rs1 - 8) << 7) |
+                                         (bit_range(u, 2, 2) << 6) | (bit_range(u, 6, 6) << 5) | ((rs2 - 8) << 2));
+        }
+        break;
+    case 0b1100111: // JALR
+        if (imm_i == 0 && rs1 != 0 && (rd == 0 || rd == ra)) return cr_type(rd == 0 ? 0b1000 : 0b1001, rs1, 0);
+        break;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @class Assembler
+ * @brief Emits RV32IC code starting at address 0, with forward and backward labels.
+ *
+ * With set_compress(true), every instruction that has a 16-bit form (see compress()) is
+ * emitted in it; references to labels stay 32 bits unless asked for with c_beqz, c_bnez
+ * and c_j.
+ */
+class Assembler {
+    struct Fixup {
+        size_t index; // in halfwords
+        std::string label;
+    };
+
+    std::vector<uint16_t> halves;
+    std::map<std::string, uint32_t> labels;
+    std::vector<Fixup> fixups;
+    bool compressing = false;
+
+    void emit_raw(uint32_t word) {
+        halves.push_back(static_cast<uint16_t>(word));
+        halves.push_back(static_cast<uint16_t>(word >> 16));
+    }
+
+    void emit(uint32_t word) {
+        if (compressing) {
+            if (auto c = compress(word)) {
+                halves.push_back(*c);
+                return;
+            }
+        }
+        emit_raw(word);
+    }
+
+    void emit_ref(uint32_t word, const std::string& target) {
+        fixups.push_back({halves.size(), target});
+        emit_raw(word);
+    }
+
+    void emit_ref(uint16_t half, const std::string& target) {
+        fixups.push_back({halves.size(), target});
+        halves.push_back(half);
+    }
+
+    static uint32_t creg(Reg r) {
+        if (!is_creg(r)) {
+            throw std::invalid_argument("not a compressed register: x" + std::to_string(r));
+        }
+        return r;
+    }
+
+    uint32_t word_at(size_t index) const { return halves[index] | static_cast<uint32_t>(halves[index + 1]) << 16; }
+
+    void set_word(size_t index, uint32_t word) {
+        halves[index] = static_cast<uint16_t>(word);
+        halves[index + 1] = static_cast<uint16_t>(word >> 16);
+    }
+
+public:
+    uint32_t here() const { return static_cast<uint32_t>(halves.size() * 2); }
+
+    void set_compress(bool on) { compressing = on; }
+
+    void label(const std::string& name) {
+        if (!labels.emplace(name, here()).second) {
+            throw std::invalid_argument("duplicate label: " + name);
+        }
+    }
+
+    // R-type
+    void add(Reg rd, Reg rs1, Reg rs2) { emit(r_type(0x00, rs2, rs1, 0b000, rd, 0b0110011)); }
+    void sub(Reg rd, Reg rs1, Reg rs2) { emit(r_type(0x20, rs2, rs1, 0b000, rd, 0b0110011)); }
+    void sll(Reg rd, Reg rs1, Reg rs2) { emit(r_type(0x00, rs2, rs1, 0b001, rd, 0b0110011)); }
+    void slt(Reg rd, Reg rs1, Reg rs2) { emit(r_type(0x00, rs2, rs1, 0b010, rd, 0b0110011)); }
+    void sltu(Reg rd, Reg rs1, Reg rs2) { emit(r_type(0x00, rs2, rs1, 0b011, rd, 0b0110011)); }
+    void xor_(Reg rd, Reg rs1, Reg rs2) { emit(r_type(0x00, rs2, rs1, 0b100, rd, 0b0110011)); }
+    void srl(Reg rd, Reg rs1, Reg rs2) { emit(r_type(0x00, rs2, rs1, 0b101, rd, 0b0110011)); }
+    void sra(Reg rd, Reg rs1, Reg rs2) { emit(r_type(0x20, rs2, rs1, 0b101, rd, 0b0110011)); }
+    void or_(Reg rd, Reg rs1, Reg rs2) { emit(r_type(0x00, rs2, rs1, 0b110, rd, 0b0110011)); }
+    void and_(Reg rd, Reg rs1, Reg rs2) { emit(r_type(0x00, rs2, rs1, 0b111, rd, 0b0110011)); }
+
+    // I-type ALU
+    void addi(Reg rd, Reg rs1, int32_t imm) { emit(i_type(imm, rs1, 0b000, rd, 0b0010011)); }
+    void slti(Reg rd, Reg rs1, int32_t imm) { emit(i_type(imm, rs1, 0b010, rd, 0b0010011)); }
+    void sltiu(Reg rd, Reg rs1, int32_t imm) { emit(i_type(imm, rs1, 0b011, rd, 0b0010011)); }
+    void xori(Reg rd, Reg rs1, int32_t imm) { emit(i_type(imm, rs1, 0b100, rd, 0b0010011)); }
+    void ori(Reg rd, Reg rs1, int32_t imm) { emit(i_type(imm, rs1, 0b110, rd, 0b0010011)); }
+    void andi(Reg rd, Reg rs1, int32_t imm) { emit(i_type(imm, rs1, 0b111, rd, 0b0010011)); }
+    void slli(Reg rd, Reg rs1, uint32_t shamt) { emit(i_type(shamt & 0x1F, rs1, 0b001, rd, 0b0010011)); }
+    void srli(Reg rd, Reg rs1, uint32_t shamt) { emit(i_type(shamt & 0x1F, rs1, 0b101, rd, 0b0010011)); }
+    void srai(Reg rd, Reg rs1, uint32_t shamt) { emit(i_type(0x400 | (shamt & 0x1F), rs1, 0b101, rd, 0b0010011)); }
+
+    // Loads and stores
+    void lb(Reg rd, int32_t off, Reg rs1) { emit(i_type(off, rs1, 0b000, rd, 0b0000011)); }
+    void lh(Reg rd, int32_t off, Reg rs1) { emit(i_type(off, rs1, 0b001, rd, 0b0000011)); }
+    void lw(Reg rd, int32_t off, Reg rs1) { emit(i_type(off, rs1, 0b010, rd, 0b0000011)); }
+    void lbu(Reg rd, int32_t off, Reg rs1) { emit(i_type(off, rs1, 0b100, rd, 0b0000011)); }
+    void lhu(Reg rd, int32_t off, Reg rs1) { emit(i_type(off, rs1, 0b101, rd, 0b0000011)); }
+    void sb(Reg rs2, int32_t off, Reg rs1) { emit(s_type(off, rs2, rs1, 0b000)); }
+    void sh(Reg rs2, int32_t off, Reg rs1) { emit(s_type(off, rs2, rs1, 0b001)); }
+    void sw(Reg rs2, int32_t off, Reg rs1) { emit(s_type(off, rs2, rs1, 0b010)); }
+
+    // Control flow (label targets are resolved by finish())
+    void beq(Reg rs1, Reg rs2, const std::string& l) { emit_ref(b_type(0, rs2, rs1, 0b000), l); }
+    void bne(Reg rs1, Reg rs2, const std::string& l) { emit_ref(b_type(0, rs2, rs1, 0b001), l); }
+    void blt(Reg rs1, Reg rs2, const std::string& l) { emit_ref(b_type(0, rs2, rs1, 0b100), l); }
+    void bge(Reg rs1, Reg rs2, const std::string& l) { emit_ref(b_type(0, rs2, rs1, 0b101), l); }
+    void bltu(Reg rs1, Reg rs2, const std::string& l) { emit_ref(b_type(0, rs2, rs1, 0b110), l); }
+    void bgeu(Reg rs1, Reg rs2, const std::string& l) { emit_ref(b_type(0, rs2, rs1, 0b111), l); }
+    void jal(Reg rd, const std::string& l) { emit_ref(j_type(0, rd), l); }
+    void jalr(Reg rd, Reg rs1, int32_t imm) { emit(i_type(imm, rs1, 0b000, rd, 0b1100111)); }
+
+    // Compressed control flow; rs1 must be one of x8-x15 and the label within reach.
+    void c_beqz(Reg rs1, const std::string& l) { emit_ref(cb_type(0, creg(rs1), 0b110), l); }
+    void c_bnez(Reg rs1, const std::string& l) { emit_ref(cb_type(0, creg(rs1), 0b111), l); }
+    void c_j(const std::string& l) { emit_ref(cj_type(0, 0b101), l); }
+
+    // Upper immediates
+    void lui(Reg rd, uint32_t imm20) { emit(u_type(imm20, rd, 0b0110111)); }
+    void auipc(Reg rd, uint32_t imm20) { emit(u_type(imm20, rd, 0b0010111)); }
+
+    // Pseudo-instructions
+    void nop() { addi(zero, zero, 0); }
+    void mv(Reg rd, Reg rs) { addi(rd, rs, 0); }
+    void j(const std::string& l) { jal(zero, l); }
+    void call(const std::string& l) { jal(ra, l); }
+    // `auipc ra, hi; jalr ra, lo(ra)`, the call sequence with a +-2 GiB reach.
+    void call_far(const std::string& l) {
+        emit_ref(u_type(0, ra, 0b0010111), l);
+        emit_raw(i_type(0, ra, 0b000, ra, 0b1100111)); // patched by the auipc fixup
+    }
+    void ret() { jalr(zero, ra, 0); }
+    void li(Reg rd, int32_t value) {
+        if (value >= -2048 && value < 2048) {
+            addi(rd, zero, value);
+            return;
+        }
+        uint32_t u = static_cast<uint32_t>(value);
+        uint32_t hi = (u + 0x800) >> 12;
+        int32_t lo = static_cast<int32_t>(u << 20) >> 20;
+        lui(rd, hi);
+        if (lo != 0) {
+            addi(rd, rd, lo);
+        }
+    }
+    void halt() { emit_raw(HALT_WORD); }
+
+    void word(uint32_t w) { emit_raw(w); }
+
+    /**
+     * @brief Resolves all label references.
+     * @return The program as a sequence of little-endian 32-bit words starting at address 0,
+     *         padded with a c.nop if it ends on a halfword.
+     * @throws std::invalid_argument on an undefined label or a compressed branch or jump
+     *         that cannot reach its label.
+     */
+    std::vector<uint32_t> finish() {
+        for (const auto& f : fixups) {
+            auto it = labels.find(f.label);
+            if (it == labels.end()) {
+                throw std::invalid_argument("undefined label: " + f.label);
+            }
+            int32_t offset = static_cast<int32_t>(it->second) - static_cast<int32_t>(f.index * 2);
+            const uint16_t half = halves[f.index];
+            if ((half & 0b11) != 0b11) {
+                const bool is_jump = (half >> 13) == 0b101;
+                if (!fits_signed(offset, is_jump ? 12 : 9)) {
+                    throw std::invalid_argument("compressed branch out of range: " + f.label);
+                }
+                halves[f.index] = is_jump ? cj_type(offset, 0b101) : cb_type(offset, 8 + ((half >> 7) & 0x7), half >> 13);
+                continue;
+            }
+            const uint32_t w = word_at(f.index);
+            if ((w & 0x7F) == 0b0010111) {
+                // auipc of an auipc/jalr pair; jalr adds the sign-extended low 12 bits.
+                uint32_t u = static_cast<uint32_t>(offset);
+                set_word(f.index, u_type((u + 0x800) >> 12, static_cast<Reg>((w >> 7) & 0x1F), 0b0010111));
+                set_word(f.index + 2, (word_at(f.index + 2) & 0xFFFFF) | (u << 20));
+                continue;
+            }
+            Reg rd = static_cast<Reg>((w >> 7) & 0x1F);
+            Reg rs1 = static_cast<Reg>((w >> 15) & 0x1F);
+            Reg rs2 = static_cast<Reg>((w >> 20) & 0x1F);
+            set_word(f.index, (w & 0x7F) == 0b1101111 ? j_type(offset, rd) : b_type(offset, rs2, rs1, (w >> 12) & 0x7));
+        }
+        fixups.clear();
+        std::vector<uint32_t> words((halves.size() + 1) / 2);
+        for (size_t i = 0; i < words.size(); ++i) {
+            const uint32_t high = 2 * i + 1 < halves.size() ? halves[2 * i + 1] : 0x0001; // c.nop
+            words[i] = halves[2 * i] | high << 16;
+        }
+        return words;
+    }
+};
+
+/**
+ * @brief Converts program words into a memory image, as produced by Loader::parse_memory_image.
+ */
+inline std::vector<std::byte> to_image(const std::vector<uint32_t>& words) {
+    std::vector<std::byte> image(words.size() * 4);
+    for (size_t i = 0; i < words.size(); ++i) {
+        for (int k = 0; k < 4; ++k) {
+            image[i * 4 + k] = static_cast<std::byte>((words[i] >> (8 * k)) & 0xFF);
+        }
+    }
+    return image;
+}
+
+/**
+ * @brief Writes program words in the loader's '@addr' text format.
+ */
+inline void write_image(std::ostream& os, const std::vector<uint32_t>& words, uint32_t base = 0) {
+    os << '@' << std::hex << std::uppercase << std::setw(8) << std::setfill('0') << base << '\n';
+    for (size_t i = 0; i < words.size(); ++i) {
+        for (int k = 0; k < 4; ++k) {
+            os << std::setw(2) << ((words[i] >> (8 * k)) & 0xFF) << ((k == 3 && i % 4 == 3) ? "" : " ");
+        }
+        if (i % 4 == 3 || i + 1 == words.size()) {
+            os << '\n';
+        }
+    }
+    os << std::dec << std::nouppercase << std::setfill(' ');
+}
+
+} // namespace rv32i
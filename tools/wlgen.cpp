@@ -0,0 +1,351 @@
+// wlgen: synthetic RV32I(C) workload generator.
+//
+// Writes a memory image in the loader's '@addr' format to stdout (or -o file). The
+// program runs an outer loop whose body is assembled from the knobs below, folds all
+// live values into a0 and halts, so the same image can be checked with the
+// co-simulation build.
+//
+//   --iterations N        outer loop trip count                               (1000)
+//   --chains K            independent dependency chains, i.e. ILP (1..8)      (2)
+//   --chain-length L      dependent ALU ops per chain per iteration           (8)
+//   --branches B          conditional branches per iteration                  (2)
+//   --taken-rate P        fraction of branch executions that are taken        (0.5)
+//   --predictability Q    fraction of branches with a fixed outcome; the rest
+//                         are driven by a run-time pseudo-random generator     (0.5)
+//   --loads N             loads per iteration                                 (2)
+//   --stores N            stores per iteration                                (1)
+//   --footprint BYTES     data footprint, rounded up to a power of two        (4096)
+//   --stride BYTES        address step between consecutive accesses           (4)
+//   --call-depth D        nested calls per iteration                          (0)
+//   --indirect H          indirect jump per iteration through H handlers,
+//                         picked by the loop counter (power of two, <=16)     (0)
+//   --fusible N           macro-op fusion idioms per iteration, in turn: a
+//                         lui/addi constant, an auipc/lw load, slt/bnez and
+//                         an auipc/jalr call                                  (0)
+//   --compressed C        1 to emit RV32C forms wherever they exist           (0)
+//   --seed S              generator seed                                      (1)
+//   -o FILE               output file                                         (stdout)
+
+#include "rv32i_asm.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace rv32i;
+
+namespace {
+
+constexpr uint32_t DATA_BASE = 0x10000;
+constexpr uint32_t MAX_FOOTPRINT = 0x40000;
+constexpr uint32_t STACK_TOP = 0xF0000;
+constexpr uint32_t MAX_CODE_BYTES = DATA_BASE;
+
+struct Knobs {
+    int32_t iterations = 1000;
+    int chains = 2;
+    int chain_length = 8;
+    int branches = 2;
+    double taken_rate = 0.5;
+    double predictability = 0.5;
+    int loads = 2;
+    int stores = 1;
+    uint32_t footprint = 4096;
+    uint32_t stride = 4;
+    int call_depth = 0;
+    int indirect = 0;
+    int fusible = 0;
+    bool compressed = false;
+    uint32_t seed = 1;
+    std::string output;
+};
+
+// Registers holding the dependency chains; everything else has a fixed role:
+// s0 loop counter, s1 data base, s2 data offset, s3 footprint mask, s4 branch
+// generator state, a0 checksum, t0-t2 scratch, sp stack.
+constexpr Reg CHAIN_REGS[] = {a1, a2, a3, a4, a5, a6, a7, t3};
+
+uint32_t round_up_pow2(uint32_t v) {
+    uint32_t p = 4;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+class Generator {
+    const Knobs& k;
+    Assembler as;
+    std::mt19937 rng;
+    int next_label = 0;
+
+    std::string fresh(const char* prefix) { return prefix + std::to_string(next_label++); }
+    double uniform() { return std::uniform_real_distribution<double>(0.0, 1.0)(rng); }
+
+    void emit_chain_step(int step) {
+        for (int c = 0; c < k.chains; ++c) {
+            Reg r = CHAIN_REGS[c];
+            switch ((step + c) % 4) {
+            case 0: as.addi(r, r, 3 + c); break;
+            case 1: as.xori(r, r, 0x155); break;
+            case 2: as.slli(t2, r, 1); as.add(r, r, t2); break;
+            default: as.srli(t2, r, 3); as.xor_(r, r, t2); break;
+            }
+        }
+    }
+
+    void emit_memory_op(bool is_store, int index) {
+        as.add(t0, s1, s2);
+        if (is_store) {
+            as.sw(CHAIN_REGS[index % k.chains], 0, t0);
+        } else {
+            as.lw(t1, 0, t0);
+            as.add(a0, a0, t1);
+        }
+        as.addi(s2, s2, static_cast<int32_t>(k.stride));
+        as.and_(s2, s2, s3);
+    }
+
+    void emit_branch() {
+        const std::string skip = fresh("skip");
+        if (uniform() < k.predictability) {
+            // Fixed outcome, decided now.
+            // The loop counter s0 is never zero inside the loop.
+            if (uniform() < k.taken_rate) {
+                k.compressed ? as.c_bnez(s0, skip) : as.beq(zero, zero, skip);
+            } else {
+                k.compressed ? as.c_beqz(s0, skip) : as.bne(zero, zero, skip);
+            }
+        } else {
+            // xorshift step, then take the branch if the low byte is below the threshold.
+            as.slli(t1, s4, 13);
+            as.xor_(s4, s4, t1);
+            as.srli(t1, s4, 17);
+            as.xor_(s4, s4, t1);
+            as.slli(t1, s4, 5);
+            as.xor_(s4, s4, t1);
+            as.andi(t1, s4, 255);
+            as.sltiu(t1, t1, static_cast<int32_t>(k.taken_rate * 256));
+            as.bne(t1, zero, skip);
+        }
+        as.addi(a0, a0, 1);
+        as.label(skip);
+    }
+
+    // Jumps to handler (s0 mod H) through a computed address. Handlers are four
+    // instructions (16 bytes) each, laid out back to back right after the jalr, so
+    // none of this is compressed.
+    void emit_indirect() {
+        const std::string join = fresh("join");
+        as.set_compress(false);
+        as.andi(t1, s0, k.indirect - 1);
+        as.slli(t1, t1, 4);
+        as.auipc(t0, 0);
+        as.add(t1, t0, t1);
+        // Not through t0: `jalr x0, t0` is a return by the RISC-V hint convention.
+        as.jalr(zero, t1, 12); // the auipc is 3 instructions before the first handler
+        for (int h = 0; h < k.indirect; ++h) {
+            as.addi(a0, a0, h + 1);
+            as.xori(a0, a0, h << 4);
+            as.j(join);
+            as.nop();
+        }
+        as.label(join);
+        as.set_compress(k.compressed);
+    }
+
+    void emit_fusible(int index) {
+        switch (index % 4) {
+        case 0:
+            as.li(t1, 0x12345 + index * 0x101); // lui + addi
+            as.add(a0, a0, t1);
+            break;
+        case 1: {
+            // auipc + lw of the first data word.
+            const uint32_t offset = DATA_BASE - as.here();
+            as.auipc(t1, (offset + 0x800) >> 12);
+            as.lw(t1, static_cast<int32_t>(offset << 20) >> 20, t1);
+            as.add(a0, a0, t1);
+            break;
+        }
+        case 2: {
+            const std::string skip = fresh("skip");
+            as.slt(t1, CHAIN_REGS[index % k.chains], a0);
+            as.bne(t1, zero, skip);
+            as.addi(a0, a0, 1);
+            as.label(skip);
+            as.add(a0, a0, t1);
+            break;
+        }
+        default:
+            as.call_far("leaf");
+            break;
+        }
+    }
+
+    void emit_functions() {
+        if (k.fusible > 3) {
+            as.label("leaf");
+            as.xori(a0, a0, 0x5A);
+            as.ret();
+        }
+        for (int d = 1; d <= k.call_depth; ++d) {
+            as.label("func" + std::to_string(d));
+            as.addi(sp, sp, -4);
+            as.sw(ra, 0, sp);
+            as.addi(a0, a0, d);
+            if (d < k.call_depth) {
+                as.call("func" + std::to_string(d + 1));
+            }
+            as.lw(ra, 0, sp);
+            as.addi(sp, sp, 4);
+            as.ret();
+        }
+    }
+
+public:
+    explicit Generator(const Knobs& knobs) : k(knobs), rng(knobs.seed) {}
+
+    std::vector<uint32_t> generate() {
+        as.set_compress(k.compressed);
+        as.li(sp, STACK_TOP);
+        as.li(s0, k.iterations);
+        as.li(s1, DATA_BASE);
+        as.li(s2, 0);
+        as.li(s3, static_cast<int32_t>(k.footprint - 1));
+        as.li(s4, static_cast<int32_t>(0x2545F491u ^ k.seed));
+        as.li(a0, 0);
+        for (int c = 0; c < k.chains; ++c) {
+            as.li(CHAIN_REGS[c], c + 1);
+        }
+
+        // Spread memory operations and branches evenly between the chain steps.
+        std::vector<int> events;
+        events.insert(events.end(), k.loads, 0);
+        events.insert(events.end(), k.stores, 1);
+        events.insert(events.end(), k.branches, 2);
+        std::shuffle(events.begin(), events.end(), rng);
+
+        as.label("loop");
+        const int slots = std::max(k.chain_length, 1);
+        size_t next_event = 0;
+        int mem_index = 0;
+        for (int step = 0; step < slots; ++step) {
+            if (step < k.chain_length) {
+                emit_chain_step(step);
+            }
+            size_t until = events.size() * (step + 1) / slots;
+            for (; next_event < until; ++next_event) {
+                if (events[next_event] == 2) {
+                    emit_branch();
+                } else {
+                    emit_memory_op(events[next_event] == 1, mem_index++);
+                }
+            }
+        }
+        if (k.call_depth > 0) {
+            as.call("func1");
+        }
+        if (k.indirect > 0) {
+            emit_indirect();
+        }
+        for (int f = 0; f < k.fusible; ++f) {
+            emit_fusible(f);
+        }
+        as.addi(s0, s0, -1);
+        as.bne(s0, zero, "loop");
+
+        for (int c = 0; c < k.chains; ++c) {
+            as.add(a0, a0, CHAIN_REGS[c]);
+        }
+        as.halt();
+        emit_functions();
+
+        auto words = as.finish();
+        if (words.size() * 4 > MAX_CODE_BYTES) {
+            throw std::invalid_argument("generated code does not fit below the data region");
+        }
+        return words;
+    }
+};
+
+void usage(const char* argv0) {
+    std::cerr << "usage: " << argv0
+              << " [--iterations N] [--chains K] [--chain-length L] [--branches B] [--taken-rate P]\n"
+                 "       [--predictability Q] [--loads N] [--stores N] [--footprint BYTES] [--stride BYTES]\n"
+                 "       [--call-depth D] [--indirect H] [--fusible N] [--compressed C] [--seed S] [-o FILE]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Knobs k;
+    for (int i = 1; i < argc; ++i) {
+        std::string opt = argv[i];
+        if (opt == "-h" || opt == "--help") {
+            usage(argv[0]);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 2;
+        }
+        const char* v = argv[++i];
+        if (opt == "--iterations") k.iterations = std::atoi(v);
+        else if (opt == "--chains") k.chains = std::atoi(v);
+        else if (opt == "--chain-length") k.chain_length = std::atoi(v);
+        else if (opt == "--branches") k.branches = std::atoi(v);
+        else if (opt == "--taken-rate") k.taken_rate = std::atof(v);
+        else if (opt == "--predictability") k.predictability = std::atof(v);
+        else if (opt == "--loads") k.loads = std::atoi(v);
+        else if (opt == "--stores") k.stores = std::atoi(v);
+        else if (opt == "--footprint") k.footprint = static_cast<uint32_t>(std::strtoul(v, nullptr, 0));
+        else if (opt == "--stride") k.stride = static_cast<uint32_t>(std::strtoul(v, nullptr, 0));
+        else if (opt == "--call-depth") k.call_depth = std::atoi(v);
+        else if (opt == "--indirect") k.indirect = std::atoi(v);
+        else if (opt == "--fusible") k.fusible = std::atoi(v);
+        else if (opt == "--compressed") k.compressed = std::atoi(v) != 0;
+        else if (opt == "--seed") k.seed = static_cast<uint32_t>(std::strtoul(v, nullptr, 0));
+        else if (opt == "-o") k.output = v;
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (k.iterations < 1 || k.chains < 1 || k.chains > 8 || k.chain_length < 0 || k.branches < 0 ||
+        k.loads < 0 || k.stores < 0 || k.call_depth < 0 || k.taken_rate < 0 || k.taken_rate > 1 ||
+        k.predictability < 0 || k.predictability > 1 || k.footprint > MAX_FOOTPRINT ||
+        k.indirect < 0 || k.indirect > 16 || (k.indirect & (k.indirect - 1)) != 0 || k.fusible < 0) {
+        std::cerr << "wlgen: knob out of range\n";
+        return 2;
+    }
+    k.footprint = round_up_pow2(k.footprint);
+    k.stride = (k.stride + 3) & ~3u;
+    if (k.stride >= 2048) {
+        std::cerr << "wlgen: stride must be below 2048 bytes\n";
+        return 2;
+    }
+
+    try {
+        auto words = Generator(k).generate();
+        if (k.output.empty()) {
+            write_image(std::cout, words);
+        } else {
+            std::ofstream out(k.output);
+            if (!out) {
+                std::cerr << "wlgen: cannot write " << k.output << "\n";
+                return 2;
+            }
+            write_image(out, words);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "wlgen: " << e.what() << "\n";
+        return 2;
+    }
+    return 0;
+}
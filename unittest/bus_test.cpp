@@ -11,37 +11,37 @@ void test_channel_basic_flow() {
     Channel<int> channel;
 
     // Initial state: channel is empty
-    assert(!channel.peek().has_value());
-    assert(!channel.receive().has_value());
+    assert(channel.peek() == nullptr);
+    assert(channel.receive() == nullptr);
 
     // Send data, but before clock tick, it's not available
     assert(channel.send(42) == true);
-    assert(!channel.peek().has_value());
+    assert(channel.peek() == nullptr);
 
     // 1. Clock tick (FALLING edge latches data from writer to reader)
     Clock::getInstance().tick();
 
     // Data is now available
-    assert(channel.peek().has_value());
-    assert(channel.peek().value() == 42);
+    assert(channel.peek() != nullptr);
+    assert(*channel.peek() == 42);
 
     // Peek again, should still be there
-    assert(channel.peek().value() == 42);
+    assert(*channel.peek() == 42);
 
     // Receive the data
     auto received_data = channel.receive();
-    assert(received_data.has_value());
-    assert(received_data.value() == 42);
+    assert(received_data != nullptr);
+    assert(*received_data == 42);
     // After receive(), data is marked as consumed but still in the slot until next tick
-    assert(channel.peek().has_value()); 
-    assert(channel.peek().value() == 42);
+    assert(channel.peek() != nullptr); 
+    assert(*channel.peek() == 42);
 
     // 2. Clock tick (FALLING edge clears the consumed data)
     Clock::getInstance().tick();
 
     // Channel should now be empty
-    assert(!channel.peek().has_value());
-    assert(!channel.receive().has_value());
+    assert(channel.peek() == nullptr);
+    assert(channel.receive() == nullptr);
     std::cout << "PASSED" << std::endl;
 }
 
@@ -63,16 +63,16 @@ void test_channel_backpressure() {
     assert(channel.send("world") == true);
 
     // The reader should see the first value, "hello"
-    assert(channel.peek().has_value());
-    assert(channel.peek().value() == "hello");
+    assert(channel.peek() != nullptr);
+    assert(*channel.peek() == "hello");
     channel.receive(); // Consume "hello"
 
     // 2. Clock tick (clears "hello", latches "world")
     Clock::getInstance().tick();
 
     // The reader should now see the second value, "world"
-    assert(channel.peek().has_value());
-    assert(channel.peek().value() == "world");
+    assert(channel.peek() != nullptr);
+    assert(*channel.peek() == "world");
     std::cout << "PASSED" << std::endl;
 }
 
@@ -84,7 +84,7 @@ void test_bus_basic_flow() {
     // Time 0: Send data
     assert(bus.send(101) == true);
     // Data is not yet available
-    assert(!bus.get().has_value());
+    assert(bus.get() == nullptr);
     assert(Clock::getInstance().getTime() == 0);
 
     // Time 1: Clock tick
@@ -94,8 +94,8 @@ void test_bus_basic_flow() {
     assert(Clock::getInstance().getTime() == 1);
 
     // Data sent at T=0 is now available at T=1
-    assert(bus.get().has_value());
-    assert(bus.get().value() == 101);
+    assert(bus.get() != nullptr);
+    assert(*bus.get() == 101);
 
     // Time 2: Clock tick
     // RISING: Bus automatically calls receive(), consuming 101.
@@ -104,7 +104,7 @@ void test_bus_basic_flow() {
     assert(Clock::getInstance().getTime() == 2);
 
     // Data is gone because it was consumed and a cycle has passed
-    assert(!bus.get().has_value());
+    assert(bus.get() == nullptr);
     std::cout << "PASSED" << std::endl;
 }
 
@@ -116,31 +116,31 @@ void test_bus_pipelined_data() {
     // Time 0:
     assert(Clock::getInstance().getTime() == 0);
     assert(bus.send(10) == true);
-    assert(!bus.get().has_value()); // Nothing to get yet
+    assert(bus.get() == nullptr); // Nothing to get yet
 
     // Time 1:
     Clock::getInstance().tick();
     assert(Clock::getInstance().getTime() == 1);
-    assert(bus.get().has_value() && bus.get().value() == 10); // Get data from T=0
+    assert(bus.get() != nullptr && *bus.get() == 10); // Get data from T=0
     assert(bus.send(20) == true); // Send next data
 
     // Time 2:
     Clock::getInstance().tick();
     assert(Clock::getInstance().getTime() == 2);
-    assert(bus.get().has_value() && bus.get().value() == 20); // Get data from T=1
+    assert(bus.get() != nullptr && *bus.get() == 20); // Get data from T=1
     assert(bus.send(30) == true); // Send next data
 
     // Time 3:
     Clock::getInstance().tick();
     assert(Clock::getInstance().getTime() == 3);
-    assert(bus.get().has_value() && bus.get().value() == 30); // Get data from T=2
+    assert(bus.get() != nullptr && *bus.get() == 30); // Get data from T=2
     // Don't send anything new
 
     // Time 4:
     Clock::getInstance().tick();
     assert(Clock::getInstance().getTime() == 4);
     // Nothing was sent at T=3, so bus is now empty
-    assert(!bus.get().has_value()); 
+    assert(bus.get() == nullptr); 
 
     std::cout << "PASSED" << std::endl;
 }